@@ -0,0 +1,243 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define RESAMPLER_SSE2
+  #include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+  #define RESAMPLER_NEON
+  #include <arm_neon.h>
+#endif
+
+#include "AudioResampler.hxx"
+
+// Taps per channel when the output rate is at least the input rate
+static const uInt32 kBaseTaps = 16;
+
+// Cutoff of the filter, as a fraction of the lower Nyquist frequency
+static const double kCutoff = 0.90;
+
+// Largest change to the rate allowed by adjustRate()
+static const double kMaxAdjustment = 0.01;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The dot product of the input with the taps of one phase; the number of
+// taps is always a multiple of 4
+static inline float dotProduct(const float* input, const float* taps,
+                               uInt32 count)
+{
+#if defined(RESAMPLER_SSE2)
+  __m128 sum = _mm_setzero_ps();
+  for(uInt32 i = 0; i < count; i += 4)
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(input + i),
+                                     _mm_loadu_ps(taps + i)));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+  return _mm_cvtss_f32(sum);
+#elif defined(RESAMPLER_NEON)
+  float32x4_t sum = vdupq_n_f32(0.0f);
+  for(uInt32 i = 0; i < count; i += 4)
+    sum = vmlaq_f32(sum, vld1q_f32(input + i), vld1q_f32(taps + i));
+  float32x2_t half = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+  return vget_lane_f32(vpadd_f32(half, half), 0);
+#else
+  float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+  for(uInt32 i = 0; i < count; i += 4)
+  {
+    s0 += input[i]   * taps[i];
+    s1 += input[i+1] * taps[i+1];
+    s2 += input[i+2] * taps[i+2];
+    s3 += input[i+3] * taps[i+3];
+  }
+  return (s0 + s1) + (s2 + s3);
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AudioResampler::AudioResampler()
+  : myChannels(1),
+    myTaps(0),
+    myKernel(0),
+    myInputCapacity(0),
+    myInputCount(0),
+    myPosition(0),
+    myBaseStep(0),
+    myStep(0)
+{
+  myInput[0] = myInput[1] = 0;
+  configure(31400, 31400, 1, 512);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AudioResampler::~AudioResampler()
+{
+  release();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioResampler::release()
+{
+  delete[] myKernel;
+  delete[] myInput[0];
+  delete[] myInput[1];
+  myKernel = 0;
+  myInput[0] = myInput[1] = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioResampler::configure(uInt32 inputRate, uInt32 outputRate,
+                               uInt32 channels, uInt32 maxOutput)
+{
+  release();
+
+  myChannels = channels == 2 ? 2 : 1;
+  myBaseStep = (uInt64)((double)inputRate / outputRate * 4294967296.0);
+  myStep = myBaseStep;
+
+  // When the output rate is lower, the filter is widened by the same
+  // factor its cutoff is lowered by, to keep the same quality
+  double ratio = BSPF_min((double)outputRate / inputRate, 1.0);
+  myTaps = ((uInt32)ceil(kBaseTaps / ratio) + 3) & ~3;
+  double cutoff = 0.5 * ratio * kCutoff;   // In cycles per input sample
+
+  // Tap i of phase p weighs the input sample (i - myTaps/2 + 1 + p/kPhases)
+  // samples before the output sample
+  myKernel = new float[myTaps * kPhases];
+  const double pi = 3.14159265358979323846;
+  for(uInt32 p = 0; p < kPhases; ++p)
+  {
+    float* taps = myKernel + p * myTaps;
+    double sum = 0.0;
+    for(uInt32 i = 0; i < myTaps; ++i)
+    {
+      double t = (double)i - (myTaps / 2 - 1) - (double)p / kPhases;
+      double x = 2.0 * pi * cutoff * t;
+      double sinc = t == 0.0 ? 1.0 : sin(x) / x;
+
+      // Blackman window over the span of the filter
+      double w = (t + myTaps / 2) / myTaps;
+      double window = w <= 0.0 || w >= 1.0 ? 0.0 :
+        0.42 - 0.5 * cos(2.0 * pi * w) + 0.08 * cos(4.0 * pi * w);
+
+      taps[i] = (float)(sinc * window);
+      sum += taps[i];
+    }
+
+    // Every phase passes DC unchanged
+    for(uInt32 i = 0; i < myTaps; ++i)
+      taps[i] = (float)(taps[i] / sum);
+  }
+
+  // Room for the input covering the largest output at the fastest rate,
+  // plus the filter span
+  myInputCapacity = (uInt32)(((double)maxOutput + 1) * myBaseStep *
+                             (1.0 + kMaxAdjustment) / 4294967296.0) +
+                    myTaps + 2;
+  for(uInt32 c = 0; c < myChannels; ++c)
+    myInput[c] = new float[myInputCapacity];
+
+  reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioResampler::reset()
+{
+  myInputCount = 0;
+  myPosition = 0;
+  myLastOutput[0] = myLastOutput[1] = 0.0f;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 AudioResampler::inputNeeded(uInt32 outputSamples) const
+{
+  if(outputSamples == 0)
+    return 0;
+
+  // The last output sample uses the input from its position onwards
+  uInt32 last = (uInt32)((myPosition + myStep * (outputSamples - 1)) >> 32);
+  uInt32 needed = last + myTaps;
+
+  return needed > myInputCount ? needed - myInputCount : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioResampler::input(const uInt8* samples, uInt32 count)
+{
+  count = BSPF_min(count, myInputCapacity - myInputCount);
+
+  if(myChannels == 1)
+  {
+    float* in = myInput[0] + myInputCount;
+    for(uInt32 i = 0; i < count; ++i)
+      in[i] = samples[i];
+  }
+  else
+  {
+    float* left  = myInput[0] + myInputCount;
+    float* right = myInput[1] + myInputCount;
+    for(uInt32 i = 0; i < count; ++i)
+    {
+      left[i]  = samples[2*i];
+      right[i] = samples[2*i+1];
+    }
+  }
+  myInputCount += count;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioResampler::adjustRate(double adjustment)
+{
+  adjustment = BSPF_max(BSPF_min(adjustment, kMaxAdjustment), -kMaxAdjustment);
+  myStep = (uInt64)(myBaseStep * (1.0 + adjustment));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioResampler::output(uInt8* samples, uInt32 count)
+{
+  for(uInt32 i = 0; i < count; ++i)
+  {
+    uInt32 index = (uInt32)(myPosition >> 32);
+    const float* taps = myKernel +
+      ((uInt32)(myPosition >> (32 - kPhaseBits)) & (kPhases - 1)) * myTaps;
+
+    for(uInt32 c = 0; c < myChannels; ++c)
+    {
+      // Hold the last sample rather than reading past the input if too
+      // little was given, so that running out doesn't click
+      if(index + myTaps <= myInputCount)
+        myLastOutput[c] = dotProduct(myInput[c] + index, taps, myTaps);
+      float value = myLastOutput[c];
+
+      Int32 sample = (Int32)(value + 0.5f);
+      *(samples++) = sample < 0 ? 0 : sample > 255 ? 255 : sample;
+    }
+    myPosition += myStep;
+  }
+
+  // Throw away the input which no later output sample can use
+  uInt32 used = BSPF_min((uInt32)(myPosition >> 32), myInputCount);
+  for(uInt32 c = 0; c < myChannels; ++c)
+    memmove(myInput[c], myInput[c] + used,
+            (myInputCount - used) * sizeof(float));
+  myInputCount -= used;
+  myPosition -= (uInt64)used << 32;
+}
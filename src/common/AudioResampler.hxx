@@ -0,0 +1,149 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef AUDIO_RESAMPLER_HXX
+#define AUDIO_RESAMPLER_HXX
+
+#include "bspf.hxx"
+
+/**
+  Converts 8-bit unsigned samples (mono, or interleaved stereo) from one
+  sample rate to another with a band-limited polyphase FIR filter.
+
+  The filter is a Blackman-windowed sinc, cut off a little below the
+  Nyquist frequency of the lower of the two rates, and tabulated for 256
+  phases between input samples.  Each output sample is one dot product of
+  the input with the taps for the nearest phase, so the cost per output
+  sample is fixed (16 multiplies per channel, or more when the output rate
+  is lower than the input rate and the filter has to be wider).  The dot
+  product uses SSE2 or NEON when the compiler targets them.
+
+  Input is added with input(), and as many output samples as it covers are
+  taken with output(); inputNeeded() answers how much input that is.
+*/
+class AudioResampler
+{
+  public:
+    /**
+      Create a resampler for mono input and output at the TIA's own rate;
+      configure() sets it up for anything else.
+    */
+    AudioResampler();
+
+    /**
+      Destructor
+    */
+    virtual ~AudioResampler();
+
+  public:
+    /**
+      Set up the resampler for the given rates, discarding any input.
+
+      @param inputRate     The sample rate of the input
+      @param outputRate    The sample rate to convert it to
+      @param channels      The number of channels (1 or 2)
+      @param maxOutput     The largest number of samples which will be
+                           asked of output() at once
+    */
+    void configure(uInt32 inputRate, uInt32 outputRate, uInt32 channels,
+                   uInt32 maxOutput);
+
+    /**
+      Discard any input which hasn't been used yet.
+    */
+    void reset();
+
+    /**
+      Answer how many more input samples must be added before the given
+      number of output samples can be taken.
+    */
+    uInt32 inputNeeded(uInt32 outputSamples) const;
+
+    /**
+      Add input samples (interleaved if stereo).  No more than inputNeeded()
+      samples may be added before the next call to output().
+    */
+    void input(const uInt8* samples, uInt32 count);
+
+    /**
+      Take output samples (interleaved if stereo).  inputNeeded() must have
+      been satisfied for the given count.
+    */
+    void output(uInt8* samples, uInt32 count);
+
+    /**
+      Speed up or slow down the conversion by a small fraction, so that
+      input arriving at a slightly different rate than expected doesn't
+      build up or run out.  The change is limited to 1% either way.
+
+      @param adjustment  The fraction to change the rate by; a positive
+                         value uses up input faster than the nominal rate
+    */
+    void adjustRate(double adjustment);
+
+    /**
+      Answers the most input which can be needed at once, for sizing the
+      buffer it's generated in.
+    */
+    uInt32 inputCapacity() const { return myInputCapacity; }
+
+    /**
+      Answers how long input takes to come out of the filter, in input
+      samples.
+    */
+    uInt32 delay() const { return myTaps / 2; }
+
+  private:
+    // Free the tables and buffers
+    void release();
+
+  private:
+    // Number of filter phases between two input samples (log base 2)
+    enum { kPhaseBits = 8, kPhases = 1 << kPhaseBits };
+
+    uInt32 myChannels;
+
+    // Number of taps in the filter (a multiple of 4), and the taps for
+    // each phase, one after the other
+    uInt32 myTaps;
+    float* myKernel;
+
+    // Input samples which haven't been used up yet, one buffer per channel
+    float* myInput[2];
+    uInt32 myInputCapacity;
+    uInt32 myInputCount;
+
+    // The last output sample of each channel, repeated if input runs out
+    float myLastOutput[2];
+
+    // Position of the next output sample in the input, and how far it
+    // moves per output sample, nominally and as adjusted (all 32.32 fixed
+    // point)
+    uInt64 myPosition;
+    uInt64 myBaseStep;
+    uInt64 myStep;
+
+  private:
+    // Copy constructor isn't supported by this class so make it private
+    AudioResampler(const AudioResampler&);
+
+    // Assignment operator isn't supported by this class so make it private
+    AudioResampler& operator = (const AudioResampler&);
+};
+
+#endif
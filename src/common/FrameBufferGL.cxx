@@ -358,8 +358,8 @@ void FrameBufferGL::drawTIA(bool fullRedraw)
   const TIA& tia = myOSystem->console().tia();
 
   // Copy the mediasource framebuffer to the RGB texture
-  uInt8* currentFrame  = tia.currentFrameBuffer();
-  uInt8* previousFrame = tia.previousFrameBuffer();
+  uInt8* currentFrame  = currentFrameBuffer();
+  uInt8* previousFrame = previousFrameBuffer();
   uInt32 width         = tia.width();
   uInt32 height        = tia.height();
   uInt32 pitch         = myTiaSurface->pitch();
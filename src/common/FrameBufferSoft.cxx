@@ -157,8 +157,8 @@ void FrameBufferSoft::drawTIA(bool fullRedraw)
 {
   const TIA& tia = myOSystem->console().tia();
 
-  uInt8* currentFrame   = tia.currentFrameBuffer();
-  uInt8* previousFrame  = tia.previousFrameBuffer();
+  uInt8* currentFrame   = currentFrameBuffer();
+  uInt8* previousFrame  = previousFrameBuffer();
 
   uInt32 width  = tia.width();
   uInt32 height = tia.height();
@@ -0,0 +1,156 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <cstring>
+
+#include "FramePipeline.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FramePipeline::FramePipeline(Producer& producer, uInt32 frameSize)
+  : myProducer(producer),
+    myCurrent(-1),
+    myPrevious(-1),
+    myReady(-1),
+    myProducing(-1),
+    myThread(0),
+    myJobFrame(0),
+    myJobDraw(false),
+    myBusyFlag(false),
+    myDrawnFlag(false),
+    myQuitFlag(false)
+{
+  for(uInt32 i = 0; i < kNumFrames; ++i)
+  {
+    myFrames[i].pixels = new uInt8[frameSize];
+    memset(myFrames[i].pixels, 0, frameSize);
+    myFrames[i].scanlines = 0;
+  }
+
+  myLock = SDL_CreateMutex();
+  myFrameStarted = SDL_CreateCond();
+  myFrameFinished = SDL_CreateCond();
+
+  myThread = SDL_CreateThread(producerThread, this);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FramePipeline::~FramePipeline()
+{
+  finish();
+
+  SDL_LockMutex(myLock);
+  myQuitFlag = true;
+  SDL_CondSignal(myFrameStarted);
+  SDL_UnlockMutex(myLock);
+
+  SDL_WaitThread(myThread, NULL);
+
+  SDL_DestroyCond(myFrameFinished);
+  SDL_DestroyCond(myFrameStarted);
+  SDL_DestroyMutex(myLock);
+
+  for(uInt32 i = 0; i < kNumFrames; ++i)
+    delete[] myFrames[i].pixels;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FramePipeline::reset()
+{
+  myCurrent = myPrevious = myReady = myProducing = -1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FramePipeline::start(bool draw)
+{
+  // Back-pressure; never more than one frame in the making
+  finish();
+
+  // Use the buffer which isn't on screen
+  myReady = -1;
+  myProducing = 0;
+  while(myProducing == myCurrent || myProducing == myPrevious)
+    ++myProducing;
+
+  SDL_LockMutex(myLock);
+  myJobFrame = &myFrames[myProducing];
+  myJobDraw = draw;
+  myBusyFlag = true;
+  SDL_CondSignal(myFrameStarted);
+  SDL_UnlockMutex(myLock);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FramePipeline::finish()
+{
+  if(myProducing < 0)
+    return;
+
+  SDL_LockMutex(myLock);
+  while(myBusyFlag)
+    SDL_CondWait(myFrameFinished, myLock);
+  bool drawn = myDrawnFlag;
+  SDL_UnlockMutex(myLock);
+
+  if(drawn)
+    myReady = myProducing;
+  myProducing = -1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FramePipeline::present()
+{
+  if(myReady < 0)
+    return false;
+
+  // The first frame is compared with and blended with itself
+  myPrevious = myCurrent >= 0 ? myCurrent : myReady;
+  myCurrent = myReady;
+  myReady = -1;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int FramePipeline::producerThread(void* pipeline)
+{
+  FramePipeline* p = (FramePipeline*) pipeline;
+
+  SDL_LockMutex(p->myLock);
+  for(;;)
+  {
+    while(p->myJobFrame == NULL && !p->myQuitFlag)
+      SDL_CondWait(p->myFrameStarted, p->myLock);
+    if(p->myQuitFlag)
+      break;
+
+    Frame* frame = p->myJobFrame;
+    bool draw = p->myJobDraw;
+    p->myJobFrame = NULL;
+    SDL_UnlockMutex(p->myLock);
+
+    bool drawn = p->myProducer.produceFrame(*frame, draw);
+
+    SDL_LockMutex(p->myLock);
+    p->myDrawnFlag = drawn;
+    p->myBusyFlag = false;
+    SDL_CondSignal(p->myFrameFinished);
+  }
+  SDL_UnlockMutex(p->myLock);
+
+  return 0;
+}
@@ -0,0 +1,185 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef FRAME_PIPELINE_HXX
+#define FRAME_PIPELINE_HXX
+
+#include <SDL.h>
+#include <SDL_thread.h>
+
+#include "bspf.hxx"
+
+/**
+  Runs the emulation one frame ahead of the screen, on a thread of its
+  own, so that a frame can be emulated while the one before it is being
+  drawn.
+
+  Frames are passed from the emulation to the screen through three
+  buffers of TIA color indices: the frame being drawn, the frame drawn
+  before it (which the drawing code compares against and blends with),
+  and the frame being emulated.  A frame which has been emulated is
+  'ready' until present() makes it the one being drawn.
+
+  The policies for a producer and consumer running at different speeds
+  are:
+
+    - Back-pressure: the emulation is never more than one frame ahead.
+      start() waits for the frame being emulated to finish before
+      starting another one.
+
+    - Skipping: the pipeline itself never drops a frame, since each one
+      is presented before the next is started (a ready frame which isn't
+      is simply overwritten).  When the screen falls behind, the caller
+      starts the next frame without drawing it instead.
+
+  The producer is only ever run between start() and finish(), so whoever
+  calls those can safely touch the state the producer uses at any other
+  time.
+*/
+class FramePipeline
+{
+  public:
+    /**
+      A frame of the TIA's output, as color indices.
+    */
+    struct Frame
+    {
+      uInt8* pixels;
+      uInt32 scanlines;
+    };
+
+    /**
+      Whatever emulates the frames.  produceFrame() is called on the
+      pipeline's thread.
+    */
+    class Producer
+    {
+      public:
+        virtual ~Producer() { }
+
+        /**
+          Emulate one frame, and copy it into the given buffer if it's
+          to be drawn.
+
+          @param frame  The buffer for the frame
+          @param draw   Whether the frame is to be drawn
+
+          @return  True if the buffer holds a new frame
+        */
+        virtual bool produceFrame(Frame& frame, bool draw) = 0;
+    };
+
+  public:
+    /**
+      Create a new pipeline, and the thread it runs the producer on.
+
+      @param producer   What to produce frames with
+      @param frameSize  The size of a frame's buffer, in bytes
+    */
+    FramePipeline(Producer& producer, uInt32 frameSize);
+
+    /**
+      Destructor; waits for the thread to exit
+    */
+    virtual ~FramePipeline();
+
+  public:
+    /**
+      Forget all the frames, so that the next one started is the first.
+      No frame may be being emulated.
+    */
+    void reset();
+
+    /**
+      Start emulating the next frame on the pipeline's thread, after
+      waiting for any frame already being emulated.
+
+      @param draw  Whether the frame is to be drawn
+    */
+    void start(bool draw);
+
+    /**
+      Wait for the frame being emulated (if any) to finish.  If it was
+      drawn, it becomes the ready frame.
+    */
+    void finish();
+
+    /**
+      Make the ready frame the one being drawn, and the one being drawn
+      the previous one.
+
+      @return  True if there was a ready frame
+    */
+    bool present();
+
+    /**
+      Answer the frame being drawn, and the one drawn before it (the same
+      frame if it's the first), or NULL if none has been presented since
+      the pipeline was reset.
+    */
+    const Frame* current() const
+      { return myCurrent >= 0 ? &myFrames[myCurrent] : NULL; }
+    const Frame* previous() const
+      { return myPrevious >= 0 ? &myFrames[myPrevious] : NULL; }
+
+  private:
+    static int producerThread(void* pipeline);
+
+  private:
+    enum { kNumFrames = 3 };
+
+    Producer& myProducer;
+
+    Frame myFrames[kNumFrames];
+
+    // Which of the frames are being drawn, were drawn before, are ready
+    // to be drawn, and are being emulated (-1 for none); only the thread
+    // calling start() and finish() uses these
+    Int32 myCurrent;
+    Int32 myPrevious;
+    Int32 myReady;
+    Int32 myProducing;
+
+    SDL_Thread* myThread;
+
+    // Protects everything below, and signals the start and end of a frame
+    SDL_mutex* myLock;
+    SDL_cond* myFrameStarted;
+    SDL_cond* myFrameFinished;
+
+    // The frame the thread should emulate, and whether it's to be drawn
+    Frame* myJobFrame;
+    bool myJobDraw;
+
+    // Set while the thread is emulating a frame, and whether the frame
+    // was drawn once it's done
+    bool myBusyFlag;
+    bool myDrawnFlag;
+
+    // Set when the thread should exit
+    bool myQuitFlag;
+
+  private:
+    // Copy constructor isn't supported by this class so make it private
+    FramePipeline(const FramePipeline&);
+
+    // Assignment operator isn't supported by this class so make it private
+    FramePipeline& operator = (const FramePipeline&);
+};
+
+#endif
@@ -60,6 +60,13 @@ bool SoundNull::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundNull::skip(Deserializer& in)
+{
+  // There's nothing to change, so loading is the same as skipping
+  return load(in);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool SoundNull::save(Serializer& out)
 {
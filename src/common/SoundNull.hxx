@@ -79,6 +79,17 @@ class SoundNull : public Sound
     */
     void setFrameRate(float framerate) { }
 
+    /**
+      Sets how many times faster than real time the emulation is running
+      (1 being real time), so that queued sound doesn't fall behind.  The
+      time between register writes is compressed by that factor, and with
+      a speed of 0 (as fast as possible) writes take effect immediately
+      without any sound being queued for them.
+
+      @param speed The speed multiplier
+    */
+    void setSpeed(uInt32 speed) { }
+
     /**
       Initializes the sound device.  This must be called before any
       calls are made to derived methods.
@@ -145,6 +156,15 @@ public:
     */
     bool load(Deserializer& in);
 
+    /**
+      Reads past the state of this device in the given Deserializer,
+      without changing the device.
+
+      @param in The deserializer device to read from.
+      @return The result of the skip.  True on success, false on failure.
+    */
+    bool skip(Deserializer& in);
+
     /**
       Saves the current state of this device to the given Serializer.
 
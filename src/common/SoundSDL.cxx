@@ -20,7 +20,6 @@
 
 #include <sstream>
 #include <cassert>
-#include <cmath>
 #include <SDL.h>
 
 #include "TIASnd.hxx"
@@ -39,6 +38,53 @@
 
 #include "SoundSDL.hxx"
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The emulation thread and the sound callback share the register write
+// queue without a lock, so each side publishes its end of the queue with
+// release semantics and reads the other's with acquire semantics
+static inline uInt32 loadAcquire(const volatile uInt32& value)
+{
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+  return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+#elif defined(__GNUC__)
+  uInt32 result = value;
+  __sync_synchronize();
+  return result;
+#else
+  return value;  // volatile accesses are ordered on the other compilers used
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static inline void storeRelease(volatile uInt32& value, uInt32 newValue)
+{
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+  __atomic_store_n(&value, newValue, __ATOMIC_RELEASE);
+#elif defined(__GNUC__)
+  __sync_synchronize();
+  value = newValue;
+#else
+  value = newValue;
+#endif
+}
+
+// The rate TIASound generates samples at, one per step of the TIA's sound
+// clock; anything else would transpose the sound, so it's the resampler
+// that converts to the rate of the sound device
+static const uInt32 kTIAFrequency = 31400;
+
+// Rate control makes the sound play faster or slower than real time by this
+// fraction per unit of relative error between the queued sound and its
+// target, up to the limit
+static const double kRateGain = 0.01;
+static const double kMaxRateCorrection = 0.005;
+
+// Time constant (in seconds) over which the queued sound is averaged
+static const double kFillTimeConstant = 0.5;
+
+// Queued sound beyond this multiple of the target is skipped over at once
+static const double kMaxFillFactor = 4.0;
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 SoundSDL::SoundSDL(OSystem* osystem)
   : Sound(osystem),
@@ -46,10 +92,14 @@ SoundSDL::SoundSDL(OSystem* osystem)
     myIsInitializedFlag(false),
     myLastRegisterSetCycle(0),
     myDisplayFrameRate(60.0),
+    mySpeed(1),
     myNumChannels(1),
-    myFragmentSizeLogBase2(0),
     myIsMuted(false),
-    myVolume(100)
+    myVolume(100),
+    myElapsedCycles(0),
+    myAverageFill(-1.0),
+    myTIABuffer(0),
+    myTIABufferSize(0)
 {
 }
 
@@ -58,6 +108,8 @@ SoundSDL::~SoundSDL()
 {
   // Close the SDL audio system if it's initialized
   close();
+
+  delete[] myTIABuffer;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -80,8 +132,14 @@ void SoundSDL::open()
   }
 
   // Make sure the sound queue is clear
+  SDL_LockAudio();
   myRegWriteQueue.clear();
+  myElapsedCycles = 0;
   myTIASound.reset();
+  myResampler.reset();
+  myAverageFill = -1.0;
+  myStats.reset();
+  SDL_UnlockAudio();
 
   if(SDL_WasInit(SDL_INIT_AUDIO) == 0)
   {
@@ -99,7 +157,6 @@ void SoundSDL::open()
     {
       uInt32 fragsize = myOSystem->settings().getInt("fragsize");
       Int32 frequency = myOSystem->settings().getInt("freq");
-      Int32 tiafreq   = myOSystem->settings().getInt("tiafreq");
 
       SDL_AudioSpec desired;
       desired.freq   = frequency;
@@ -134,7 +191,6 @@ void SoundSDL::open()
 
       myIsInitializedFlag = true;
       myIsMuted = false;
-      myFragmentSizeLogBase2 = log((double)myHardwareSpec.samples) / log(2.0);
 
 		/*
         cerr << "Freq: " << (int)myHardwareSpec.freq << endl;
@@ -145,11 +201,19 @@ void SoundSDL::open()
         cerr << "Size: " << (int)myHardwareSpec.size << endl;
 		  */
 
-      // Now initialize the TIASound object which will actually generate sound
-      myTIASound.outputFrequency(myHardwareSpec.freq);
-      myTIASound.tiaFrequency(tiafreq);
+      // Now initialize the TIASound object which will actually generate
+      // sound; it makes one sample per TIA step, which are resampled to the
+      // rate of the sound device
+      myTIASound.outputFrequency(kTIAFrequency);
+      myTIASound.tiaFrequency(kTIAFrequency);
       myTIASound.channels(myHardwareSpec.channels);
 
+      myResampler.configure(kTIAFrequency, myHardwareSpec.freq,
+                            myHardwareSpec.channels, myHardwareSpec.samples);
+      delete[] myTIABuffer;
+      myTIABufferSize = myResampler.inputCapacity();
+      myTIABuffer = new uInt8[myTIABufferSize * myHardwareSpec.channels];
+
       bool clipvol = myOSystem->settings().getBool("clipvol");
       myTIASound.clipVolume(clipvol);
 
@@ -164,7 +228,7 @@ void SoundSDL::open()
              << "  Frag size  : " << fragsize << endl
              << "  Frequency  : " << myHardwareSpec.freq << endl
              << "  Format     : " << myHardwareSpec.format << endl
-             << "  TIA Freq.  : " << tiafreq << endl
+             << "  TIA Freq.  : " << kTIAFrequency << endl
              << "  Channels   : " << myNumChannels << endl
              << "  Clip volume: " << (int)clipvol << endl << endl;
     }
@@ -206,8 +270,19 @@ void SoundSDL::mute(bool state)
 
     myIsMuted = state;
 
-    SDL_PauseAudio(myIsMuted ? 1 : 0);
+    // While muted the callback isn't run, and set() changes the registers
+    // directly instead of queueing the writes
+    if(myIsMuted)
+      SDL_PauseAudio(1);
+    SDL_LockAudio();
     myRegWriteQueue.clear();
+    myElapsedCycles = 0;
+    myResampler.reset();
+    myAverageFill = -1.0;
+    myStats.restart();
+    SDL_UnlockAudio();
+    if(!myIsMuted)
+      SDL_PauseAudio(0);
   }
 }
 
@@ -216,11 +291,16 @@ void SoundSDL::reset()
 {
   if(myIsInitializedFlag)
   {
-    SDL_PauseAudio(1);
+    SDL_LockAudio();
     myIsMuted = false;
     myLastRegisterSetCycle = 0;
     myTIASound.reset();
     myRegWriteQueue.clear();
+    myElapsedCycles = 0;
+    myResampler.reset();
+    myAverageFill = -1.0;
+    myStats.restart();
+    SDL_UnlockAudio();
     SDL_PauseAudio(0);
   }
 }
@@ -270,6 +350,13 @@ void SoundSDL::adjustVolume(Int8 direction)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL::adjustCycleCounter(Int32 amount)
 {
+  // The counter is wound back to zero at the start of every frame; a write
+  // to no register (which TIASound ignores) is queued at the end of the
+  // last one, so that the sound callback knows how much time has been
+  // emulated even when the game leaves the sound registers alone
+  if(amount < 0)
+    set(0, 0, -amount);
+
   myLastRegisterSetCycle += amount;
 }
 
@@ -288,31 +375,39 @@ void SoundSDL::setFrameRate(float framerate)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL::set(uInt16 addr, uInt8 value, Int32 cycle)
+void SoundSDL::setSpeed(uInt32 speed)
 {
   SDL_LockAudio();
+  mySpeed = speed;
+  SDL_UnlockAudio();
+}
 
-  // First, calulate how many seconds would have past since the last
-  // register write on a real 2600
-  double delta = (((double)(cycle - myLastRegisterSetCycle)) / 
-      (1193191.66666667));
-
-  // Now, adjust the time based on the frame rate the user has selected. For
-  // the sound to "scale" correctly, we have to know the games real frame 
-  // rate (e.g., 50 or 60) and the currently emulated frame rate. We use these
-  // values to "scale" the time before the register change occurs.
-// FIXME - this always results in 1.0, so we don't really need it
-//  delta = delta * (myDisplayFrameRate / myOSystem->frameRate());
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL::set(uInt16 addr, uInt8 value, Int32 cycle)
+{
+  // Nothing is playing, so just keep the registers up to date
+  if(!myIsInitializedFlag || myIsMuted)
+  {
+    myTIASound.set(addr, value);
+    myLastRegisterSetCycle = cycle;
+    return;
+  }
+
+  // This is called for every sound register write, so it never waits for
+  // the sound callback; the write is queued along with the number of CPU
+  // cycles since the previous one, and the callback works out when it
+  // should be heard.  When running as fast as possible there's no way to
+  // keep up with the writes, so the sound just follows the registers.
   RegWrite info;
   info.addr = addr;
   info.value = value;
-  info.delta = delta;
-  myRegWriteQueue.enqueue(info);
+  info.delta = (mySpeed == 0 || cycle < myLastRegisterSetCycle) ? 0 :
+               (uInt32)(cycle - myLastRegisterSetCycle);
+  if(!myRegWriteQueue.enqueue(info))
+    myStats.overflow();
 
   // Update last cycle counter to the current cycle
   myLastRegisterSetCycle = cycle;
-
-  SDL_UnlockAudio();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -321,91 +416,158 @@ void SoundSDL::processFragment(uInt8* stream, Int32 length)
   if(!myIsInitializedFlag)
     return;
 
-  uInt32 channels = myHardwareSpec.channels;
-  length = length / channels;
+  length = length / myHardwareSpec.channels;
+
+  double fill = controlRate(length);
+
+  // Once a write reaches the end of the queue, it's heard after the sound
+  // queued ahead of it, the delay of the resampling filter, and the
+  // fragment the sound card is playing while this one is filled
+  double period = (double)length / myHardwareSpec.freq;
+  double latency = (myAverageFill < 0.0 ? fill : myAverageFill) +
+                   (double)myResampler.delay() / kTIAFrequency + period;
+  myStats.fragment(myOSystem->getTicks(), (uInt32)(period * 1000000.0),
+                   (uInt32)(fill * 1000000.0), (uInt32)(latency * 1000000.0));
+
+  // Make just enough sound at the TIA rate to resample into the fragment
+  uInt32 needed = BSPF_min(myResampler.inputNeeded(length), myTIABufferSize);
+  processTIASound(myTIABuffer, needed);
+  myResampler.input(myTIABuffer, needed);
+  myResampler.output(stream, length);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+double SoundSDL::controlRate(Int32 length)
+{
+  // Running as fast as possible, nothing is queued to control
+  if(mySpeed == 0)
+  {
+    myResampler.adjustRate(0.0);
+    myStats.rateControl(0, 0, 0, false);
+    return 0.0;
+  }
 
-  // If there are excessive items on the queue then we'll remove some
-  if(myRegWriteQueue.duration() > 
-      (myFragmentSizeLogBase2 / myDisplayFrameRate))
+  // How much sound is queued, from what's been played of the write at the
+  // front of the queue to the end of the last frame emulated
+  double cyclesPerSecond = 1193191.66666667 * mySpeed;
+  uInt64 queued = myRegWriteQueue.duration();
+  uInt64 played = myElapsedCycles >> 16;
+  double fill = queued > played ? (queued - played) / cyclesPerSecond : 0.0;
+
+  // Frames are emulated in bursts, so the queue has to hold more than a
+  // frame to last until the next one, plus a fragment to fill from it
+  double target = 1.0 / myDisplayFrameRate +
+                  (double)myHardwareSpec.samples / myHardwareSpec.freq;
+
+  // Far more than that (after the callback was held up, say) would take
+  // too long to play off by adjusting the rate, so the oldest writes are
+  // applied straight away, leaving only the target amount
+  if(fill > target * kMaxFillFactor)
   {
-    double removed = 0.0;
-    while(removed < ((myFragmentSizeLogBase2 - 1) / myDisplayFrameRate))
+    uInt64 keep = (uInt64)(target * cyclesPerSecond);
+    uInt64 skipped = 0;
+    uInt32 writes = 0;
+    RegWrite* info;
+    while(queued - skipped > keep && (info = myRegWriteQueue.front()) != NULL)
     {
-      RegWrite& info = myRegWriteQueue.front();
-      removed += info.delta;
-      myTIASound.set(info.addr, info.value);
+      skipped += info->delta;
+      myTIASound.set(info->addr, info->value);
       myRegWriteQueue.dequeue();
+      ++writes;
     }
-//    cout << "Removed Items from RegWriteQueue!" << endl;
+    myElapsedCycles = 0;
+    myStats.skipped(writes);
+    fill = myAverageFill = target;
   }
 
-  double position = 0.0;
-  double remaining = length;
+  // The queue fills a frame at a time and drains a fragment at a time, so
+  // it's averaged over several frames before being compared to the target
+  if(myAverageFill < 0.0)
+    myAverageFill = fill;
+  else
+    myAverageFill += (fill - myAverageFill) *
+      BSPF_min((double)length / myHardwareSpec.freq / kFillTimeConstant, 1.0);
+
+  // Play a little faster when there's too much queued, and a little slower
+  // when there's too little; the change in pitch is too small to hear
+  double correction = kRateGain * (myAverageFill - target) / target;
+  bool limited = correction > kMaxRateCorrection ||
+                 correction < -kMaxRateCorrection;
+  if(limited)
+    correction = correction > 0.0 ? kMaxRateCorrection : -kMaxRateCorrection;
+  myResampler.adjustRate(correction);
+
+  myStats.rateControl((uInt32)(myAverageFill * 1000000.0),
+                      (uInt32)(target * 1000000.0),
+                      (Int32)(correction * 1000000.0), limited);
+
+  return fill;
+}
 
-  while(remaining > 0.0)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL::processTIASound(uInt8* stream, Int32 length)
+{
+  uInt32 channels = myHardwareSpec.channels;
+
+  // How many CPU cycles each sample takes to play on a real 2600 (in 16.16
+  // fixed point), compressed when running faster than real time
+  double cyclesPerSecond = 1193191.66666667 * BSPF_max(mySpeed, 1u);
+  uInt64 cyclesPerSample =
+    (uInt64)(cyclesPerSecond * 65536.0 / kTIAFrequency);
+
+  // Time played past a register write carries over to the next one, but
+  // no more than a fragment's worth, so that writes which arrive late
+  // aren't all squeezed together trying to catch up
+  uInt64 maxCarry = cyclesPerSample * myTIABufferSize;
+
+  Int32 position = 0;
+  while(position < length)
   {
-    if(myRegWriteQueue.size() == 0)
+    RegWrite* info = myRegWriteQueue.front();
+    if(info == NULL)
     {
-      // There are no more pending TIA sound register updates so we'll
-      // use the current settings to finish filling the sound fragment
-//    myTIASound.process(stream + (uInt32)position, length - (uInt32)position);
-      myTIASound.process(stream + ((uInt32)position * channels),
-          length - (uInt32)position);
-
-      // Since we had to fill the fragment we'll reset the cycle counter
-      // to zero.  NOTE: This isn't 100% correct, however, it'll do for
-      // now.  We should really remember the overrun and remove it from
-      // the delta of the next write.
-      myLastRegisterSetCycle = 0;
+      // The emulation hasn't got this far yet, so we'll use the current
+      // settings to finish filling the buffer; the time this takes isn't
+      // counted, so later writes are delayed rather than squeezed together
+      myTIASound.process(stream + (position * channels), length - position);
+      myStats.underrun();
       break;
     }
-    else
-    {
-      // There are pending TIA sound register updates so we need to
-      // update the sound buffer to the point of the next register update
-      RegWrite& info = myRegWriteQueue.front();
 
-      // How long will the remaining samples in the fragment take to play
-      double duration = remaining / (double)myHardwareSpec.freq;
+    // If the register update time hasn't already passed then process
+    // samples upto the point where it should occur (rounded up)
+    uInt64 delta = (uInt64)info->delta << 16;
+    if(delta > myElapsedCycles)
+    {
+      uInt64 samples =
+        (delta - myElapsedCycles + cyclesPerSample - 1) / cyclesPerSample;
 
-      // Does the register update occur before the end of the fragment?
-      if(info.delta <= duration)
+      // The next register update occurs in the next fragment so finish
+      // the buffer with the current TIA settings
+      if(samples > (uInt64)(length - position))
       {
-        // If the register update time hasn't already passed then
-        // process samples upto the point where it should occur
-        if(info.delta > 0.0)
-        {
-          // Process the fragment upto the next TIA register write.  We
-          // round the count passed to process up if needed.
-          double samples = (myHardwareSpec.freq * info.delta);
-//        myTIASound.process(stream + (uInt32)position, (uInt32)samples +
-//            (uInt32)(position + samples) - 
-//            ((uInt32)position + (uInt32)samples));
-          myTIASound.process(stream + ((uInt32)position * channels),
-              (uInt32)samples + (uInt32)(position + samples) - 
-              ((uInt32)position + (uInt32)samples));
-
-          position += samples;
-          remaining -= samples;
-        }
-        myTIASound.set(info.addr, info.value);
-        myRegWriteQueue.dequeue();
-      }
-      else
-      {
-        // The next register update occurs in the next fragment so finish
-        // this fragment with the current TIA settings and reduce the register
-        // update delay by the corresponding amount of time
-//      myTIASound.process(stream + (uInt32)position, length - (uInt32)position);
-        myTIASound.process(stream + ((uInt32)position * channels),
-            length - (uInt32)position);
-        info.delta -= duration;
+        myTIASound.process(stream + (position * channels), length - position);
+        myElapsedCycles += cyclesPerSample * (length - position);
         break;
       }
+
+      myTIASound.process(stream + (position * channels), (uInt32)samples);
+      myElapsedCycles += cyclesPerSample * samples;
+      position += (Int32)samples;
     }
+
+    myElapsedCycles = BSPF_min(myElapsedCycles - delta, maxCarry);
+    myTIASound.set(info->addr, info->value);
+    myRegWriteQueue.dequeue();
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const SoundStats* SoundSDL::stats() const
+{
+  return &myStats;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL::callback(void* udata, uInt8* stream, int len)
 {
@@ -458,15 +620,16 @@ bool SoundSDL::load(Deserializer& in)
     // Make sure to empty the queue of previous sound fragments
     if(myIsInitializedFlag)
     {
-      SDL_PauseAudio(1);
+      SDL_LockAudio();
       myRegWriteQueue.clear();
+      myElapsedCycles = 0;
       myTIASound.set(0x15, reg1);
       myTIASound.set(0x16, reg2);
       myTIASound.set(0x17, reg3);
       myTIASound.set(0x18, reg4);
       myTIASound.set(0x19, reg5);
       myTIASound.set(0x1a, reg6);
-      SDL_PauseAudio(0);
+      SDL_UnlockAudio();
     }
   }
   catch(char *msg)
@@ -483,6 +646,35 @@ bool SoundSDL::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundSDL::skip(Deserializer& in)
+{
+  string device = "TIASound";
+
+  try
+  {
+    if(in.getString() != device)
+      return false;
+
+    // The six sound registers, and myLastRegisterSetCycle
+    for(uInt32 i = 0; i < 6; ++i)
+      in.getByte();
+    in.getInt();
+  }
+  catch(char *msg)
+  {
+    cerr << msg << endl;
+    return false;
+  }
+  catch(...)
+  {
+    cerr << "Unknown error in skip state for " << device << endl;
+    return false;
+  }
+
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool SoundSDL::save(Serializer& out)
 {
@@ -532,10 +724,10 @@ bool SoundSDL::save(Serializer& out)
 SoundSDL::RegWriteQueue::RegWriteQueue(uInt32 capacity)
   : myCapacity(capacity),
     myBuffer(0),
-    mySize(0),
     myHead(0),
     myTail(0)
 {
+  assert((myCapacity & (myCapacity - 1)) == 0);
   myBuffer = new RegWrite[myCapacity];
 }
 
@@ -548,71 +740,56 @@ SoundSDL::RegWriteQueue::~RegWriteQueue()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL::RegWriteQueue::clear()
 {
-  myHead = myTail = mySize = 0;
+  storeRelease(myHead, loadAcquire(myTail));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL::RegWriteQueue::dequeue()
 {
-  if(mySize > 0)
-  {
-    myHead = (myHead + 1) % myCapacity;
-    --mySize;
-  }
+  uInt32 head = myHead;
+  if(head != loadAcquire(myTail))
+    storeRelease(myHead, head + 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-double SoundSDL::RegWriteQueue::duration()
+uInt64 SoundSDL::RegWriteQueue::duration() const
 {
-  double duration = 0.0;
-  for(uInt32 i = 0; i < mySize; ++i)
-  {
-    duration += myBuffer[(myHead + i) % myCapacity].delta;
-  }
+  uInt64 duration = 0;
+  uInt32 tail = loadAcquire(myTail);
+  for(uInt32 i = myHead; i != tail; ++i)
+    duration += myBuffer[i & (myCapacity - 1)].delta;
+
   return duration;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL::RegWriteQueue::enqueue(const RegWrite& info)
+bool SoundSDL::RegWriteQueue::enqueue(const RegWrite& info)
 {
-  // If an attempt is made to enqueue more than the queue can hold then
-  // we'll enlarge the queue's capacity.
-  if(mySize == myCapacity)
-  {
-    grow();
-  }
+  // The head and tail are counts which wrap around, so their difference is
+  // the size even after they do
+  uInt32 tail = myTail;
+  if(tail - loadAcquire(myHead) == myCapacity)
+    return false;
 
-  myBuffer[myTail] = info;
-  myTail = (myTail + 1) % myCapacity;
-  ++mySize;
+  myBuffer[tail & (myCapacity - 1)] = info;
+  storeRelease(myTail, tail + 1);
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-SoundSDL::RegWrite& SoundSDL::RegWriteQueue::front()
+SoundSDL::RegWrite* SoundSDL::RegWriteQueue::front()
 {
-  assert(mySize != 0);
-  return myBuffer[myHead];
-}
+  uInt32 head = myHead;
+  if(head == loadAcquire(myTail))
+    return NULL;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 SoundSDL::RegWriteQueue::size() const
-{
-  return mySize;
+  return &myBuffer[head & (myCapacity - 1)];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL::RegWriteQueue::grow()
+uInt32 SoundSDL::RegWriteQueue::size() const
 {
-  RegWrite* buffer = new RegWrite[myCapacity * 2];
-  for(uInt32 i = 0; i < mySize; ++i)
-  {
-    buffer[i] = myBuffer[(myHead + i) % myCapacity];
-  }
-  myHead = 0;
-  myTail = mySize;
-  myCapacity = myCapacity * 2;
-  delete[] myBuffer;
-  myBuffer = buffer;
+  return loadAcquire(myTail) - loadAcquire(myHead);
 }
 
 #endif  // SOUND_SUPPORT
@@ -28,6 +28,8 @@ class OSystem;
 #include "bspf.hxx"
 #include "TIASnd.hxx"
 #include "Sound.hxx"
+#include "SoundStats.hxx"
+#include "AudioResampler.hxx"
 
 /**
   This class implements the sound API for SDL.
@@ -60,6 +62,8 @@ class SoundSDL : public Sound
     /**
       The system cycle counter is being adjusting by the specified amount. Any
       members using the system cycle counter should be adjusted as needed.
+      This happens at the start of every frame, so it's also where the sound
+      callback is told how much time has been emulated.
 
       @param amount The amount the cycle counter is being adjusted by
     */
@@ -80,6 +84,17 @@ class SoundSDL : public Sound
     */
     void setFrameRate(float framerate);
 
+    /**
+      Sets how many times faster than real time the emulation is running
+      (1 being real time), so that queued sound doesn't fall behind.  The
+      time between register writes is compressed by that factor, and with
+      a speed of 0 (as fast as possible) writes take effect immediately
+      without any sound being queued for them.
+
+      @param speed The speed multiplier
+    */
+    void setSpeed(uInt32 speed);
+
     /**
       Initializes the sound device.  This must be called before any
       calls are made to derived methods.
@@ -137,6 +152,13 @@ class SoundSDL : public Sound
     */
     void adjustVolume(Int8 direction);
 
+    /**
+      Answers statistics about how well the sound is keeping up with the
+      sound card (underruns, dropped writes, jitter, queue depth, rate
+      control and latency).
+    */
+    const SoundStats* stats() const;
+
   public:
     /**
       Loads the current state of this device from the given Deserializer.
@@ -146,6 +168,15 @@ class SoundSDL : public Sound
     */
     bool load(Deserializer& in);
 
+    /**
+      Reads past the state of this device in the given Deserializer,
+      without changing the device.
+
+      @param in The deserializer device to read from.
+      @return The result of the skip.  True on success, false on failure.
+    */
+    bool skip(Deserializer& in);
+
     /**
       Saves the current state of this device to the given Serializer.
 
@@ -163,28 +194,51 @@ class SoundSDL : public Sound
     */
     void processFragment(uInt8* stream, Int32 length);
 
+    /**
+      Adjust the rate at which queued sound is played (by resampling it a
+      little faster or slower) according to how much is queued, so that
+      the queue stays at its target level.
+
+      @param length Number of samples in the fragment about to be played
+      @return The amount of sound queued, in seconds
+    */
+    double controlRate(Int32 length);
+
+    /**
+      Generate sound at the TIA rate, applying the queued register writes
+      at the right times.
+
+      @param stream Pointer to the start of the buffer
+      @param length Number of samples to generate
+    */
+    void processTIASound(uInt8* stream, Int32 length);
+
   protected:
     // Struct to hold information regarding a TIA sound register write
     struct RegWrite
     {
       uInt16 addr;
       uInt8 value;
-      double delta;
+      uInt32 delta;   // CPU cycles since the previous write
     };
 
     /**
       A queue class used to hold TIA sound register writes before being
       processed while creating a sound fragment.
+
+      The emulation thread is the only one to enqueue items, and the sound
+      callback is the only one to look at or dequeue them, so neither side
+      ever has to wait for the other.  The queue doesn't grow; anything
+      enqueued while it's full is dropped.
     */
     class RegWriteQueue
     {
       public:
         /**
-          Create a new queue instance with the specified initial
-          capacity.  If the queue ever reaches its capacity then it will
-          automatically increase its size.
+          Create a new queue instance with the specified capacity, which
+          must be a power of two.
         */
-        RegWriteQueue(uInt32 capacity = 512);
+        RegWriteQueue(uInt32 capacity = 8192);
 
         /**
           Destroy this queue instance.
@@ -193,31 +247,35 @@ class SoundSDL : public Sound
 
       public:
         /**
-          Clear any items stored in the queue.
+          Clear any items stored in the queue.  Neither side may be using
+          the queue at the same time (the sound callback must be locked).
         */
         void clear();
 
         /**
-          Dequeue the first object in the queue.
+          Dequeue the first object in the queue (sound callback only).
         */
         void dequeue();
 
         /**
-          Return the duration of all the items in the queue.
+          Return the duration in CPU cycles of all the items in the queue
+          (sound callback only).
         */
-        double duration();
+        uInt64 duration() const;
 
         /**
-          Enqueue the specified object.
+          Enqueue the specified object (emulation thread only).
+
+          @return False if the queue was full, and the object was dropped
         */
-        void enqueue(const RegWrite& info);
+        bool enqueue(const RegWrite& info);
 
         /**
-          Return the item at the front on the queue.
+          Return the item at the front on the queue (sound callback only).
 
-          @return The item at the front of the queue.
+          @return The item at the front of the queue, or NULL if it's empty
         */
-        RegWrite& front();
+        RegWrite* front();
 
         /**
           Answers the number of items currently in the queue.
@@ -226,16 +284,25 @@ class SoundSDL : public Sound
         */
         uInt32 size() const;
 
-      private:
-        // Increase the size of the queue
-        void grow();
-
       private:
         uInt32 myCapacity;
         RegWrite* myBuffer;
-        uInt32 mySize;
-        uInt32 myHead;
-        uInt32 myTail;
+
+        // Count of items ever dequeued, written only by the sound callback
+        volatile uInt32 myHead;
+
+        // Keep the two sides of the queue off each other's cache line
+        uInt8 myPadding[64];
+
+        // Count of items ever enqueued, written only by the emulation thread
+        volatile uInt32 myTail;
+
+      private:
+        // Copy constructor isn't supported by this class so make it private
+        RegWriteQueue(const RegWriteQueue&);
+
+        // Assignment operator isn't supported by this class so make it private
+        RegWriteQueue& operator = (const RegWriteQueue&);
     };
 
   private:
@@ -254,12 +321,12 @@ class SoundSDL : public Sound
     // Indicates the base framerate depending on if the ROM is NTSC or PAL
     float myDisplayFrameRate;
 
+    // How many times faster than real time the emulation is running
+    uInt32 mySpeed;
+
     // Indicates the number of channels (mono or stereo)
     uInt32 myNumChannels;
 
-    // Log base 2 of the selected fragment size
-    double myFragmentSizeLogBase2;
-
     // Indicates if the sound is currently muted
     bool myIsMuted;
 
@@ -272,6 +339,24 @@ class SoundSDL : public Sound
     // Queue of TIA register writes
     RegWriteQueue myRegWriteQueue;
 
+    // CPU cycles (in 16.16 fixed point) played by the sound callback since
+    // the last register write it applied
+    uInt64 myElapsedCycles;
+
+    // Amount of sound queued, averaged by the sound callback (in seconds,
+    // or negative before the first fragment)
+    double myAverageFill;
+
+    // Statistics about the sound, recorded as it plays
+    SoundStats myStats;
+
+    // Converts the sound from the TIA's rate to the device's rate
+    AudioResampler myResampler;
+
+    // Sound at the TIA rate for the fragment being filled
+    uInt8* myTIABuffer;
+    uInt32 myTIABufferSize;
+
   private:
     // Callback function invoked by the SDL Audio library when it needs data
     static void callback(void* udata, uInt8* stream, int len);
@@ -0,0 +1,204 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include "ThreadPool.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThreadPool::ThreadPool(uInt32 threads)
+  : myNumThreads(BSPF_max(threads, 1u)),
+    myShares(0),
+    myThreads(0),
+    myWorkers(0),
+    myJob(0),
+    myNumFinished(0),
+    myGeneration(0),
+    myQuitFlag(false)
+{
+  myLock = SDL_CreateMutex();
+  myJobStarted = SDL_CreateCond();
+  myJobFinished = SDL_CreateCond();
+
+  myShares = new Share[myNumThreads];
+  for(uInt32 i = 0; i < myNumThreads; ++i)
+  {
+    myShares[i].lock = SDL_CreateMutex();
+    myShares[i].begin = myShares[i].end = 0;
+  }
+
+  // Thread 0 is whoever calls run()
+  myThreads = new SDL_Thread*[myNumThreads];
+  myWorkers = new Worker[myNumThreads];
+  myThreads[0] = 0;
+  for(uInt32 i = 1; i < myNumThreads; ++i)
+  {
+    myWorkers[i].pool = this;
+    myWorkers[i].id = i;
+    myThreads[i] = SDL_CreateThread(workerThread, &myWorkers[i]);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThreadPool::~ThreadPool()
+{
+  SDL_LockMutex(myLock);
+  myQuitFlag = true;
+  SDL_CondBroadcast(myJobStarted);
+  SDL_UnlockMutex(myLock);
+
+  for(uInt32 i = 1; i < myNumThreads; ++i)
+    SDL_WaitThread(myThreads[i], NULL);
+
+  for(uInt32 i = 0; i < myNumThreads; ++i)
+    SDL_DestroyMutex(myShares[i].lock);
+
+  delete[] myShares;
+  delete[] myThreads;
+  delete[] myWorkers;
+
+  SDL_DestroyCond(myJobFinished);
+  SDL_DestroyCond(myJobStarted);
+  SDL_DestroyMutex(myLock);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThreadPool::run(Job& job, uInt32 count)
+{
+  if(myNumThreads == 1)
+  {
+    for(uInt32 i = 0; i < count; ++i)
+      job.run(i);
+    return;
+  }
+
+  // Nobody else is looking at the shares between jobs, so they can be
+  // set up without locking them
+  for(uInt32 i = 0; i < myNumThreads; ++i)
+  {
+    myShares[i].begin = (uInt32)((uInt64)count * i / myNumThreads);
+    myShares[i].end   = (uInt32)((uInt64)count * (i + 1) / myNumThreads);
+  }
+
+  SDL_LockMutex(myLock);
+  myJob = &job;
+  myNumFinished = 0;
+  ++myGeneration;
+  SDL_CondBroadcast(myJobStarted);
+  SDL_UnlockMutex(myLock);
+
+  work(0);
+
+  SDL_LockMutex(myLock);
+  ++myNumFinished;
+  while(myNumFinished < myNumThreads)
+    SDL_CondWait(myJobFinished, myLock);
+  myJob = 0;
+  SDL_UnlockMutex(myLock);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThreadPool::work(uInt32 id)
+{
+  // Items which were stolen are run before this thread reports that it's
+  // finished, so once every thread has finished, every item has been run
+  uInt32 item;
+  do
+  {
+    while(take(id, item))
+      myJob->run(item);
+  }
+  while(steal(id));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ThreadPool::take(uInt32 id, uInt32& item)
+{
+  Share& share = myShares[id];
+  bool taken = false;
+
+  SDL_LockMutex(share.lock);
+  if(share.begin < share.end)
+  {
+    item = share.begin++;
+    taken = true;
+  }
+  SDL_UnlockMutex(share.lock);
+
+  return taken;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ThreadPool::steal(uInt32 id)
+{
+  for(uInt32 i = 1; i < myNumThreads; ++i)
+  {
+    Share& victim = myShares[(id + i) % myNumThreads];
+
+    SDL_LockMutex(victim.lock);
+    uInt32 left = victim.end - victim.begin;
+    if(left == 0)
+    {
+      SDL_UnlockMutex(victim.lock);
+      continue;
+    }
+
+    // Take the back half (the items the victim would get to last)
+    uInt32 end = victim.end;
+    victim.end -= (left + 1) / 2;
+    uInt32 begin = victim.end;
+    SDL_UnlockMutex(victim.lock);
+
+    Share& share = myShares[id];
+    SDL_LockMutex(share.lock);
+    share.begin = begin;
+    share.end = end;
+    SDL_UnlockMutex(share.lock);
+
+    return true;
+  }
+
+  return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int ThreadPool::workerThread(void* worker)
+{
+  ThreadPool& pool = *((Worker*)worker)->pool;
+  uInt32 id = ((Worker*)worker)->id;
+  uInt32 generation = 0;
+
+  for(;;)
+  {
+    SDL_LockMutex(pool.myLock);
+    while(pool.myGeneration == generation && !pool.myQuitFlag)
+      SDL_CondWait(pool.myJobStarted, pool.myLock);
+    if(pool.myQuitFlag)
+    {
+      SDL_UnlockMutex(pool.myLock);
+      return 0;
+    }
+    generation = pool.myGeneration;
+    SDL_UnlockMutex(pool.myLock);
+
+    pool.work(id);
+
+    SDL_LockMutex(pool.myLock);
+    if(++pool.myNumFinished == pool.myNumThreads)
+      SDL_CondSignal(pool.myJobFinished);
+    SDL_UnlockMutex(pool.myLock);
+  }
+}
@@ -0,0 +1,155 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef THREAD_POOL_HXX
+#define THREAD_POOL_HXX
+
+#include <SDL.h>
+#include <SDL_thread.h>
+
+#include "bspf.hxx"
+
+/**
+  A fixed set of threads which run the items of a job in parallel.
+
+  The items of a job are numbered 0 to count-1.  Each thread starts with
+  an equal, contiguous share of them, and takes items from the front of
+  its share.  A thread which runs out steals the back half of another
+  thread's share, so that items which take longer than others (a console
+  which happens to be bankswitching or drawing more) don't leave the
+  other threads idle at the end of the job.
+
+  The thread calling run() works on the job too, so a pool of N threads
+  only creates N-1 of its own.
+*/
+class ThreadPool
+{
+  public:
+    /**
+      A job which can be run by the pool.  run(i) is called exactly once
+      for every item i, from any of the threads, so it must only touch
+      state belonging to that item.
+    */
+    class Job
+    {
+      public:
+        virtual ~Job() { }
+        virtual void run(uInt32 item) = 0;
+    };
+
+  public:
+    /**
+      Create a new pool.
+
+      @param threads  The number of threads to run jobs on, including
+                      the one calling run()
+    */
+    ThreadPool(uInt32 threads);
+
+    /**
+      Destructor; waits for the threads to exit
+    */
+    virtual ~ThreadPool();
+
+  public:
+    /**
+      Run every item of the given job, and return once they're all done.
+
+      @param job    The job to run
+      @param count  The number of items in the job
+    */
+    void run(Job& job, uInt32 count);
+
+    /**
+      Answer the number of threads jobs are run on.
+    */
+    uInt32 threads() const { return myNumThreads; }
+
+  private:
+    // The items which are still to be run by one of the threads
+    struct Share
+    {
+      SDL_mutex* lock;
+      uInt32 begin, end;
+    };
+
+    // The arguments for each of the threads created by the pool
+    struct Worker
+    {
+      ThreadPool* pool;
+      uInt32 id;
+    };
+
+    /**
+      Run items of the current job until none are left anywhere.
+
+      @param id  The thread doing the work (0 is the one calling run())
+    */
+    void work(uInt32 id);
+
+    /**
+      Take the next item from the given thread's share.
+
+      @return  True if there was an item left
+    */
+    bool take(uInt32 id, uInt32& item);
+
+    /**
+      Move the back half of another thread's share to the given thread.
+
+      @return  True if there was anything to steal
+    */
+    bool steal(uInt32 id);
+
+    static int workerThread(void* worker);
+
+  private:
+    uInt32 myNumThreads;
+
+    // One share of the current job per thread
+    Share* myShares;
+
+    // The threads created by the pool, and their arguments
+    SDL_Thread** myThreads;
+    Worker* myWorkers;
+
+    // Protects everything below, and signals the start and end of a job
+    SDL_mutex* myLock;
+    SDL_cond* myJobStarted;
+    SDL_cond* myJobFinished;
+
+    // The job being run, and how many threads have finished with it
+    Job* myJob;
+    uInt32 myNumFinished;
+
+    // Incremented for every job, so that threads can tell a new one has
+    // started
+    uInt32 myGeneration;
+
+    // Set when the threads should exit
+    bool myQuitFlag;
+
+  private:
+    // Copy constructor isn't supported by this class so make it private
+    ThreadPool(const ThreadPool&);
+
+    // Assignment operator isn't supported by this class so make it private
+    ThreadPool& operator = (const ThreadPool&);
+};
+
+#endif
@@ -7,6 +7,9 @@ MODULE_OBJS := \
 	src/common/FrameBufferSoft.o \
 	src/common/FrameBufferGL.o \
 	src/common/RectList.o \
+	src/common/ThreadPool.o \
+	src/common/AudioResampler.o \
+	src/common/FramePipeline.o \
 	src/common/Snapshot.o
 
 MODULE_DIRS += \
@@ -123,12 +123,6 @@ Debugger::Debugger(OSystem* osystem)
   myBreakPoints = new PackedBitArray(0x10000);
   myReadTraps = new PackedBitArray(0x10000);
   myWriteTraps = new PackedBitArray(0x10000);
-
-  // Allow access to this object from any class
-  // Technically this violates pure OO programming, but since I know
-  // there will only be ever one instance of debugger in Stella,
-  // I don't care :)
-  myStaticDebugger = this;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -150,6 +144,12 @@ Debugger::~Debugger()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Debugger::initialize()
 {
+  // Allow access to this object from any class
+  // Technically this violates pure OO programming, but only the debugger
+  // attached to the console on screen is ever initialized, so this can't
+  // be changed by headless OSystems running in other threads
+  myStaticDebugger = this;
+
   const GUI::Rect& r = getDialogBounds();
 
   delete myBaseDialog;
@@ -58,6 +58,18 @@ Cartridge* Cartridge::create(const uInt8* image, uInt32 size,
 {
   Cartridge* cartridge = 0;
 
+  // Images smaller than 4K are repeated to fill it, the same as a small ROM
+  // chip appears at every mirror of its addresses; otherwise the 2K and 4K
+  // cartridges would copy whatever happens to follow the image in memory
+  uInt8 mirrored[4096];
+  if(size > 0 && size < 4096 && size != 2048)
+  {
+    for(uInt32 i = 0; i < 4096; ++i)
+      mirrored[i] = image[i % size];
+    image = mirrored;
+    size = 4096;
+  }
+
   // Get the type of the cartridge we're creating
   const string& md5 = properties.get(Cartridge_MD5);
   string type = properties.get(Cartridge_Type);
@@ -89,7 +101,6 @@ Cartridge* Cartridge::create(const uInt8* image, uInt32 size,
     type = detected;
   }
   buf << type << autodetect << " (" << (size/1024) << "K) ";
-  myAboutString = buf.str();
 
   // We should know the cart's type by now so let's create it
   if(type == "2K")
@@ -149,11 +160,16 @@ Cartridge* Cartridge::create(const uInt8* image, uInt32 size,
   else
     cerr << "ERROR: Invalid cartridge type " << type << " ..." << endl;
 
+  if(cartridge)
+    cartridge->myAboutString = buf.str();
+
   return cartridge;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Cartridge::Cartridge()
+  : myBankAccess(0),
+    myBankAccessPages(0)
 {
   unlockBank();
 }
@@ -161,6 +177,40 @@ Cartridge::Cartridge()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Cartridge::~Cartridge()
 {
+  delete[] myBankAccess;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::createBankAccess(uInt8* image, uInt16 banks,
+                                 uInt16 bankSize, uInt16 start, uInt16 end)
+{
+  uInt16 shift = mySystem->pageShift();
+
+  delete[] myBankAccess;
+  myBankAccessPages = (end - start) >> shift;
+  myBankAccess = new System::PageAccess[banks * myBankAccessPages];
+
+  System::PageAccess* access = myBankAccess;
+  for(uInt32 bank = 0; bank < banks; ++bank)
+  {
+    for(uInt32 address = start; address < end; address += (1 << shift))
+    {
+      access->directPeekBase =
+        &image[bank * bankSize + (address & (bankSize - 1))];
+      access->directPokeBase = 0;
+      access->device = this;
+      ++access;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::installBankAccess(uInt16 bank, uInt16 address)
+{
+  assert(myBankAccess != 0);
+
+  mySystem->setPageAccess(address >> mySystem->pageShift(), myBankAccessPages,
+                          &myBankAccess[bank * myBankAccessPages]);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -549,6 +599,3 @@ Cartridge& Cartridge::operator = (const Cartridge&)
   assert(false);
   return *this;
 }
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-string Cartridge::myAboutString= "";
@@ -28,6 +28,7 @@ class Settings;
 
 #include "bspf.hxx"
 #include "Device.hxx"
+#include "System.hxx"
 
 /**
   A cartridge is a device which contains the machine code for a 
@@ -65,7 +66,7 @@ class Cartridge : public Device
     /**
       Query some information about this cartridge.
     */
-    static const string& about() { return myAboutString; }
+    const string& about() const { return myAboutString; }
 
     /**
       Save the internal (patched) ROM image.
@@ -142,11 +143,46 @@ class Cartridge : public Device
     */
     virtual string name() const = 0;
 
+  protected:
+    /**
+      Precompute the page accesses which map each bank of the ROM image
+      into the address range [start, end) of the system, so that bank()
+      can switch banks with installBankAccess() instead of setting every
+      page itself.  Must be called from install(), once the page size of
+      the system is known.
+
+      @param image     A pointer to the ROM image
+      @param banks     The number of banks in the image
+      @param bankSize  The size of each bank (a power of two)
+      @param start     The first address the banks are mapped at
+      @param end       The address following the last mapped address
+    */
+    void createBankAccess(uInt8* image, uInt16 banks, uInt16 bankSize,
+                          uInt16 start, uInt16 end);
+
+    /**
+      Map the given bank into the system, using the page accesses
+      precomputed by createBankAccess().
+
+      @param bank     The bank to map
+      @param address  The address to map it at (normally the 'start'
+                      given to createBankAccess(), but any address with
+                      the same offset within a bank works)
+    */
+    void installBankAccess(uInt16 bank, uInt16 address);
+
   protected:
     // If myBankLocked is true, ignore attempts at bankswitching. This is used
     // by the debugger, when disassembling/dumping ROM.
     bool myBankLocked;
 
+  private:
+    // Page accesses for each bank, as precomputed by createBankAccess()
+    System::PageAccess* myBankAccess;
+
+    // Number of pages in each bank of myBankAccess
+    uInt16 myBankAccessPages;
+
   private:
     /**
       Try to auto-detect the bankswitching type of the cartridge
@@ -234,7 +270,7 @@ class Cartridge : public Device
 
   private:
     // Contains info about this cartridge in string format
-    static string myAboutString;
+    string myAboutString;
 
     // Copy constructor isn't supported by cartridges so make it private
     Cartridge(const Cartridge&);
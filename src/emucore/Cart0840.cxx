@@ -74,6 +74,10 @@ void Cartridge0840::install(System& system)
     mySystem->setPageAccess(i >> shift, access);
   }
 
+  // Precompute the page accesses for every bank, so that switching banks
+  // only needs to copy them into the system
+  createBankAccess(myImage, 2, 4096, 0x1000, 0x2000);
+
   // Install pages for bank 0
   bank(0);
 }
@@ -149,21 +153,9 @@ void Cartridge0840::bank(uInt16 bank)
 
   // Remember what bank we're in
   myCurrentBank = bank;
-  uInt16 offset = myCurrentBank * 4096;
-  uInt16 shift = mySystem->pageShift();
-
-  // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
-  access.directPokeBase = 0;
 
   // Map ROM image into the system
-  for(uInt32 address = 0x1000; address < 0x2000; address += (1 << shift))
-  {
-    access.directPeekBase = &myImage[offset + (address & 0x0FFF)];
-    mySystem->setPageAccess(address >> shift, access);
-  }
-
+  installBankAccess(myCurrentBank, 0x1000);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
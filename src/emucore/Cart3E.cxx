@@ -45,7 +45,7 @@ Cartridge3E::~Cartridge3E()
 void Cartridge3E::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 32768; ++i)
     myRam[i] = random.next();
 
@@ -119,6 +119,31 @@ class Cartridge4K : public Cartridge
     */
     virtual string name() const { return "Cartridge4K"; }
 
+    /**
+      Answers the number of bytes used by cloneState().
+
+      @return The size of the state snapshot
+    */
+    uInt32 stateSize() const;
+
+    /**
+      Copies the current state of this device to the given buffer
+      (see Device::cloneState()).
+
+      @param state  The buffer of stateSize() bytes to copy the state to
+      @return  The number of bytes copied (always stateSize())
+    */
+    uInt32 cloneState(uInt8* state) const;
+
+    /**
+      Restores the state of this device from a snapshot which was taken
+      by cloneState().
+
+      @param state  The buffer to restore the state from
+      @return  The number of bytes used from the buffer
+    */
+    uInt32 restoreState(const uInt8* state);
+
   public:
     /**
       Get the byte at the specified address.
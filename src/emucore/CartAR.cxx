@@ -47,7 +47,7 @@ CartridgeAR::~CartridgeAR()
 void CartridgeAR::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 6 * 1024; ++i)
     myImage[i] = random.next();
 
@@ -281,7 +281,7 @@ void CartridgeAR::bankConfiguration(uInt8 configuration)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeAR::initializeROM(bool fastbios)
 {
-  static uInt8 dummyROMCode[] = {
+  static const uInt8 dummyROMCode[] = {
     0xa5, 0xfa, 0x85, 0x80, 0x4c, 0x18, 0xf8, 0xff, 
     0xff, 0xff, 0x78, 0xd8, 0xa0, 0x0, 0xa2, 0x0, 
     0x94, 0x0, 0xe8, 0xd0, 0xfb, 0x4c, 0x50, 0xf8, 
@@ -321,11 +321,6 @@ void CartridgeAR::initializeROM(bool fastbios)
     0x4c
   };
 
-  // If fastbios is enabled, set the wait time between vertical bars
-  // to 0 (default is 8), which is stored at address 189 of the bios
-  if(fastbios)
-    dummyROMCode[189] = 0x0;
-
   uInt32 size = sizeof(dummyROMCode);
 
   // Initialize ROM with illegal 6502 opcode that causes a real 6502 to jam
@@ -340,6 +335,11 @@ void CartridgeAR::initializeROM(bool fastbios)
     myImage[3 * 2048 + j] = dummyROMCode[j];
   }
 
+  // If fastbios is enabled, set the wait time between vertical bars
+  // to 0 (default is 8), which is stored at address 189 of the bios
+  if(fastbios)
+    myImage[3 * 2048 + 189] = 0x0;
+
   // Finally set 6502 vectors to point to initial load code at 0xF80A of BIOS
   myImage[3 * 2048 + 2044] = 0x0A;
   myImage[3 * 2048 + 2045] = 0xF8;
@@ -30,8 +30,6 @@ CartridgeCV::CartridgeCV(const uInt8* image, uInt32 size)
 {
   myROM = new uInt8[mySize];
   memcpy(myROM, image, mySize);
-
-  reset();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -49,7 +47,7 @@ void CartridgeCV::reset()
     memcpy(myImage, myROM, 2048);
 
     // Initialize RAM with random values
-    class Random random;
+    Random& random = mySystem->randGenerator();
     for(uInt32 i = 0; i < 1024; ++i)
       myRAM[i] = random.next();
   }
@@ -76,6 +76,10 @@ void CartridgeE0::install(System& system)
     mySystem->setPageAccess(j >> shift, access);
   }
 
+  // Precompute the page accesses for every 1K slice; segments 0 to 2 all
+  // map slices the same way, so the same accesses work for each of them
+  createBankAccess(myImage, 8, 1024, 0x1000, 0x1400);
+
   // Install some default slices for the other segments
   segmentZero(4);
   segmentOne(5);
@@ -131,19 +135,9 @@ void CartridgeE0::segmentZero(uInt16 slice)
 
   // Remember the new slice
   myCurrentSlice[0] = slice;
-  uInt16 offset = slice << 10;
-  uInt16 shift = mySystem->pageShift();
-
-  // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
-  access.directPokeBase = 0;
 
-  for(uInt32 address = 0x1000; address < 0x1400; address += (1 << shift))
-  {
-    access.directPeekBase = &myImage[offset + (address & 0x03FF)];
-    mySystem->setPageAccess(address >> shift, access);
-  }
+  // Map the slice into the system
+  installBankAccess(slice, 0x1000);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -153,19 +147,9 @@ void CartridgeE0::segmentOne(uInt16 slice)
 
   // Remember the new slice
   myCurrentSlice[1] = slice;
-  uInt16 offset = slice << 10;
-  uInt16 shift = mySystem->pageShift();
-
-  // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
-  access.directPokeBase = 0;
 
-  for(uInt32 address = 0x1400; address < 0x1800; address += (1 << shift))
-  {
-    access.directPeekBase = &myImage[offset + (address & 0x03FF)];
-    mySystem->setPageAccess(address >> shift, access);
-  }
+  // Map the slice into the system
+  installBankAccess(slice, 0x1400);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -175,19 +159,9 @@ void CartridgeE0::segmentTwo(uInt16 slice)
 
   // Remember the new slice
   myCurrentSlice[2] = slice;
-  uInt16 offset = slice << 10;
-  uInt16 shift = mySystem->pageShift();
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
-  access.directPokeBase = 0;
-
-  for(uInt32 address = 0x1800; address < 0x1C00; address += (1 << shift))
-  {
-    access.directPeekBase = &myImage[offset + (address & 0x03FF)];
-    mySystem->setPageAccess(address >> shift, access);
-  }
+  // Map the slice into the system
+  installBankAccess(slice, 0x1800);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
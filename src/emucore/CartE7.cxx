@@ -39,7 +39,7 @@ CartridgeE7::~CartridgeE7()
 void CartridgeE7::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 2048; ++i)
     myRAM[i] = random.next();
 
@@ -61,6 +61,10 @@ void CartridgeEF::install(System& system)
     mySystem->setPageAccess(i >> shift, access);
   }
 
+  // Precompute the page accesses for every bank, so that switching banks
+  // only needs to copy them into the system
+  createBankAccess(myImage, 16, 4096, 0x1000, (0x1FE0U & ~mask));
+
   // Install pages for bank 1
   bank(1);
 }
@@ -94,22 +98,9 @@ void CartridgeEF::bank(uInt16 bank)
 
   // Remember what bank we're in
   myCurrentBank = bank;
-  uInt16 offset = myCurrentBank * 4096;
-  uInt16 shift = mySystem->pageShift();
-  uInt16 mask = mySystem->pageMask();
-
-  // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
-  access.directPokeBase = 0;
 
   // Map ROM image into the system
-  for(uInt32 address = 0x1000; address < (0x1FE0U & ~mask);
-      address += (1 << shift))
-  {
-    access.directPeekBase = &myImage[offset + (address & 0x0FFF)];
-    mySystem->setPageAccess(address >> shift, access);
-  }
+  installBankAccess(myCurrentBank, 0x1000);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -39,7 +39,7 @@ CartridgeEFSC::~CartridgeEFSC()
 void CartridgeEFSC::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 128; ++i)
     myRAM[i] = random.next();
 
@@ -85,6 +85,10 @@ void CartridgeEFSC::install(System& system)
     mySystem->setPageAccess(k >> shift, access);
   }
 
+  // Precompute the page accesses for every bank, so that switching banks
+  // only needs to copy them into the system
+  createBankAccess(myImage, 16, 4096, 0x1100, (0x1FE0U & ~mask));
+
   // Install pages for bank 1
   bank(1);
 }
@@ -125,22 +129,9 @@ void CartridgeEFSC::bank(uInt16 bank)
 
   // Remember what bank we're in
   myCurrentBank = bank;
-  uInt16 offset = myCurrentBank * 4096;
-  uInt16 shift = mySystem->pageShift();
-  uInt16 mask = mySystem->pageMask();
-
-  // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
-  access.directPokeBase = 0;
 
   // Map ROM image into the system
-  for(uInt32 address = 0x1100; address < (0x1FE0U & ~mask);
-      address += (1 << shift))
-  {
-    access.directPeekBase = &myImage[offset + (address & 0x0FFF)];
-    mySystem->setPageAccess(address >> shift, access);
-  }
+  installBankAccess(myCurrentBank, 0x1100);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
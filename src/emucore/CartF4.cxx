@@ -17,6 +17,7 @@
 //============================================================================
 
 #include <cassert>
+#include <cstring>
 
 #include "Random.hxx"
 #include "System.hxx"
@@ -64,6 +65,10 @@ void CartridgeF4::install(System& system)
     mySystem->setPageAccess(i >> shift, access);
   }
 
+  // Precompute the page accesses for every bank, so that switching banks
+  // only needs to copy them into the system
+  createBankAccess(myImage, 8, 4096, 0x1000, (0x1FF4U & ~mask));
+
   // Install pages for bank 0
   bank(0);
 }
@@ -101,22 +106,9 @@ void CartridgeF4::bank(uInt16 bank)
 
   // Remember what bank we're in
   myCurrentBank = bank;
-  uInt16 offset = myCurrentBank * 4096;
-  uInt16 shift = mySystem->pageShift();
-  uInt16 mask = mySystem->pageMask();
-
-  // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
-  access.directPokeBase = 0;
 
   // Map ROM image into the system
-  for(uInt32 address = 0x1000; address < (0x1FF4U & ~mask);
-      address += (1 << shift))
-  {
-    access.directPeekBase = &myImage[offset + (address & 0x0FFF)];
-    mySystem->setPageAccess(address >> shift, access);
-  }
+  installBankAccess(myCurrentBank, 0x1000);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -146,6 +138,31 @@ uInt8* CartridgeF4::getImage(int& size)
   return &myImage[0];
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 CartridgeF4::stateSize() const
+{
+  return sizeof(myCurrentBank);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 CartridgeF4::cloneState(uInt8* state) const
+{
+  memcpy(state, &myCurrentBank, sizeof(myCurrentBank));
+  return sizeof(myCurrentBank);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 CartridgeF4::restoreState(const uInt8* state)
+{
+  uInt16 current;
+  memcpy(&current, state, sizeof(current));
+
+  // Remember what bank we were in
+  bank(current);
+
+  return sizeof(current);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartridgeF4::save(Serializer& out) const
 {
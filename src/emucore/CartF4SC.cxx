@@ -39,7 +39,7 @@ CartridgeF4SC::~CartridgeF4SC()
 void CartridgeF4SC::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 128; ++i)
     myRAM[i] = random.next();
 
@@ -85,6 +85,10 @@ void CartridgeF4SC::install(System& system)
     mySystem->setPageAccess(k >> shift, access);
   }
 
+  // Precompute the page accesses for every bank, so that switching banks
+  // only needs to copy them into the system
+  createBankAccess(myImage, 8, 4096, 0x1100, (0x1FF4U & ~mask));
+
   // Install pages for bank 0
   bank(0);
 }
@@ -127,22 +131,9 @@ void CartridgeF4SC::bank(uInt16 bank)
 
   // Remember what bank we're in
   myCurrentBank = bank;
-  uInt16 offset = myCurrentBank * 4096;
-  uInt16 shift = mySystem->pageShift();
-  uInt16 mask = mySystem->pageMask();
-
-  // Setup the page access methods for the current bank
-  System::PageAccess access;
-  access.device = this;
-  access.directPokeBase = 0;
 
   // Map ROM image into the system
-  for(uInt32 address = 0x1100; address < (0x1FF4U & ~mask);
-      address += (1 << shift))
-  {
-    access.directPeekBase = &myImage[offset + (address & 0x0FFF)];
-    mySystem->setPageAccess(address >> shift, access);
-  }
+  installBankAccess(myCurrentBank, 0x1100);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -172,6 +163,34 @@ uInt8* CartridgeF4SC::getImage(int& size)
   return &myImage[0];
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 CartridgeF4SC::stateSize() const
+{
+  return sizeof(myCurrentBank) + 128;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 CartridgeF4SC::cloneState(uInt8* state) const
+{
+  memcpy(state, &myCurrentBank, sizeof(myCurrentBank));
+  memcpy(state + sizeof(myCurrentBank), myRAM, 128);
+
+  return sizeof(myCurrentBank) + 128;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 CartridgeF4SC::restoreState(const uInt8* state)
+{
+  uInt16 current;
+  memcpy(&current, state, sizeof(current));
+  memcpy(myRAM, state + sizeof(current), 128);
+
+  // Remember what bank we were in
+  bank(current);
+
+  return sizeof(current) + 128;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartridgeF4SC::save(Serializer& out) const
 {
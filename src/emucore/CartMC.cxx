@@ -46,7 +46,7 @@ CartridgeMC::~CartridgeMC()
 void CartridgeMC::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 32768; ++i)
     myRAM[i] = random.next();
 }
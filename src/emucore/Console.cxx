@@ -17,6 +17,7 @@
 //============================================================================
 
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <fstream>
@@ -83,14 +84,32 @@ Console::Console(OSystem* osystem, Cartridge* cart, const Properties& props)
   // Attach the event subsystem to the current console
   myEvent = myOSystem->eventHandler().event();
 
-  // Load user-defined palette for this ROM
+  // Take a copy of the built-in palettes, and load the user-defined
+  // palette for this ROM
+  memcpy(myPalettes[0][0], ourNTSCPalette, sizeof(ourNTSCPalette));
+  memcpy(myPalettes[0][1], ourPALPalette, sizeof(ourPALPalette));
+  memcpy(myPalettes[0][2], ourSECAMPalette, sizeof(ourSECAMPalette));
+  memcpy(myPalettes[1][0], ourNTSCPaletteZ26, sizeof(ourNTSCPaletteZ26));
+  memcpy(myPalettes[1][1], ourPALPaletteZ26, sizeof(ourPALPaletteZ26));
+  memcpy(myPalettes[1][2], ourSECAMPaletteZ26, sizeof(ourSECAMPaletteZ26));
   loadUserPalette();
+  setColorLossPalette(myOSystem->settings().getBool("colorloss"));
 
   // Create switches for the console
   mySwitches = new Switches(*myEvent, myProperties);
 
   // Construct the system and components
-  mySystem = new System(13, 6);
+  // Per-address decoding keeps bankswitch hotspots from disabling direct
+  // access for the rest of their page, but makes bankswitching slower
+  if(myOSystem->settings().getString("decode") == "address")
+    mySystem = new System(13, 0);
+  else
+    mySystem = new System(13, 6);
+
+  // Seed the system's random number generator (used to randomize RAM on
+  // reset); a fixed seed makes the console start up the same way every time
+  uInt32 seed = (uInt32) myOSystem->settings().getInt("randseed");
+  mySystem->randGenerator().initSeed(seed != 0 ? seed : myOSystem->getTicks());
 
   // The real controllers for this console will be added later
   // For now, we just add dummy joystick controllers, since autodetection
@@ -240,6 +259,60 @@ bool Console::save(Serializer& out) const
   return true;  // success
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Console::stateSize() const
+{
+  return mySystem->stateSize() + 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 Console::cloneState(uInt8* state) const
+{
+  uInt32 size = mySystem->cloneState(state);
+  state[size++] = mySwitches->read();
+
+  return stateHash(state, size);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::restoreState(const uInt8* state)
+{
+  uInt32 size = mySystem->restoreState(state);
+  mySwitches->write(state[size]);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 Console::stateHash(const uInt8* state, uInt32 size)
+{
+  // Multiply/xor over 8-byte words, followed by a final mix so that every
+  // bit of the snapshot affects every bit of the result
+  const uInt64 k = 0x9e3779b97f4a7c15ULL;
+  uInt64 hash = size * k;
+
+  uInt32 i = 0;
+  for(; i + 8 <= size; i += 8)
+  {
+    uInt64 word;
+    memcpy(&word, state + i, 8);
+    hash = (hash ^ word) * k;
+    hash ^= hash >> 29;
+  }
+  if(i < size)
+  {
+    uInt64 word = 0;
+    memcpy(&word, state + i, size - i);
+    hash = (hash ^ word) * k;
+  }
+
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+
+  return hash;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Console::load(Deserializer& in)
 {
@@ -377,20 +450,12 @@ void Console::togglePalette()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Console::setPalette(const string& type)
 {
-  // Look at all the palettes, since we don't know which one is
-  // currently active
-  uInt32* palettes[3][3] = {
-    { &ourNTSCPalette[0],    &ourPALPalette[0],    &ourSECAMPalette[0]    },
-    { &ourNTSCPaletteZ26[0], &ourPALPaletteZ26[0], &ourSECAMPaletteZ26[0] },
-    { 0, 0, 0 }
-  };
-  if(myUserPaletteDefined)
-  {
-    palettes[2][0] = &ourUserNTSCPalette[0];
-    palettes[2][1] = &ourUserPALPalette[0];
-    palettes[2][2] = &ourUserSECAMPalette[0];
-  }
+  myOSystem->frameBuffer().setTIAPalette(palette(type));
+}
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt32* Console::palette(const string& type) const
+{
   // See which format we should be using
   int paletteNum = 0;
   if(type == "standard")
@@ -401,12 +466,10 @@ void Console::setPalette(const string& type)
     paletteNum = 2;
 
   // Now consider the current display format
-  const uInt32* palette =
-    (myDisplayFormat.compare(0, 3, "PAL") == 0)   ? palettes[paletteNum][1] :
-    (myDisplayFormat.compare(0, 5, "SECAM") == 0) ? palettes[paletteNum][2] :
-     palettes[paletteNum][0];
-
-  myOSystem->frameBuffer().setTIAPalette(palette);
+  return
+    (myDisplayFormat.compare(0, 3, "PAL") == 0)   ? myPalettes[paletteNum][1] :
+    (myDisplayFormat.compare(0, 5, "SECAM") == 0) ? myPalettes[paletteNum][2] :
+     myPalettes[paletteNum][0];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -514,8 +577,9 @@ void Console::initializeAudio()
 */
 void Console::fry() const
 {
-  for (int ZPmem=0; ZPmem<0x100; ZPmem += rand() % 4)
-    mySystem->poke(ZPmem, mySystem->peek(ZPmem) & (uInt8)rand() % 256);
+  Random& random = mySystem->randGenerator();
+  for (int ZPmem=0; ZPmem<0x100; ZPmem += random.next() % 4)
+    mySystem->poke(ZPmem, mySystem->peek(ZPmem) & (uInt8)random.next() % 256);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -617,7 +681,6 @@ void Console::setControllers(const string& rommd5)
 
   // Also check if we should swap the paddles plugged into a jack
   bool swapPaddles = myProperties.get(Controller_SwapPaddles) == "YES";
-  Paddles::setMouseIsPaddle(-1);  // Reset to defaults
 
   // Construct left controller
   if(left == "BOOSTERGRIP")
@@ -717,6 +780,24 @@ void Console::setControllers(const string& rommd5)
   {
     myControllers[rightPort] = new Joystick(Controller::Right, *myEvent, *mySystem);
   }
+
+  setPaddleSpeed(myOSystem->settings().getInt("pspeed"));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::setPaddleMode(int number)
+{
+  for(int i = 0; i < 2; ++i)
+    if(myControllers[i]->type() == Controller::Paddles)
+      static_cast<Paddles*>(myControllers[i])->setMouseIsPaddle(number);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::setPaddleSpeed(int speed)
+{
+  for(int i = 0; i < 2; ++i)
+    if(myControllers[i]->type() == Controller::Paddles)
+      static_cast<Paddles*>(myControllers[i])->setDigitalSpeed(speed);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -763,13 +844,13 @@ void Console::loadUserPalette()
   {
     in.read((char*)pixbuf, 3);
     uInt32 pixel = ((int)pixbuf[0] << 16) + ((int)pixbuf[1] << 8) + (int)pixbuf[2];
-    ourUserNTSCPalette[(i<<1)] = pixel;
+    myPalettes[2][0][(i<<1)] = pixel;
   }
   for(int i = 0; i < 128; i++)  // PAL palette
   {
     in.read((char*)pixbuf, 3);
     uInt32 pixel = ((int)pixbuf[0] << 16) + ((int)pixbuf[1] << 8) + (int)pixbuf[2];
-    ourUserPALPalette[(i<<1)] = pixel;
+    myPalettes[2][1][(i<<1)] = pixel;
   }
 
   uInt32 secam[16];  // All 8 24-bit pixels, plus 8 colorloss pixels
@@ -780,7 +861,7 @@ void Console::loadUserPalette()
     secam[(i<<1)]   = pixel;
     secam[(i<<1)+1] = 0;
   }
-  uInt32* ptr = ourUserSECAMPalette;
+  uInt32* ptr = myPalettes[2][2];
   for(int i = 0; i < 16; ++i)
   {
     uInt32* s = secam;
@@ -797,29 +878,17 @@ void Console::setColorLossPalette(bool loss)
 {
   // Look at all the palettes, since we don't know which one is
   // currently active
-  uInt32* palette[9] = {
-    &ourNTSCPalette[0],    &ourPALPalette[0],    &ourSECAMPalette[0],
-    &ourNTSCPaletteZ26[0], &ourPALPaletteZ26[0], &ourSECAMPaletteZ26[0],
-    0, 0, 0
-  };
-  if(myUserPaletteDefined)
-  {
-    palette[6] = &ourUserNTSCPalette[0];
-    palette[7] = &ourUserPALPalette[0];
-    palette[8] = &ourUserSECAMPalette[0];
-  }
-
-  for(int i = 0; i < 9; ++i)
+  int numPalettes = myUserPaletteDefined ? 9 : 6;
+  for(int i = 0; i < numPalettes; ++i)
   {
-    if(palette[i] == 0)
-      continue;
+    uInt32* palette = myPalettes[i / 3][i % 3];
 
     // If color-loss is enabled, fill the odd numbered palette entries
     // with gray values (calculated using the standard RGB -> grayscale
     // conversion formula)
     for(int j = 0; j < 128; ++j)
     {
-      uInt32 pixel = palette[i][(j<<1)];
+      uInt32 pixel = palette[(j<<1)];
       if(loss)
       {
         uInt8 r = (pixel >> 16) & 0xff;
@@ -830,7 +899,7 @@ void Console::setColorLossPalette(bool loss)
                              ((float)b * 0.1140));
         pixel = (sum << 16) + (sum << 8) + sum;
       }
-      palette[i][(j<<1)+1] = pixel;
+      palette[(j<<1)+1] = pixel;
     }
   }
 }
@@ -844,7 +913,7 @@ void Console::setFramerate(float framerate)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Console::ourNTSCPalette[256] = {
+const uInt32 Console::ourNTSCPalette[256] = {
   0x000000, 0, 0x4a4a4a, 0, 0x6f6f6f, 0, 0x8e8e8e, 0,
   0xaaaaaa, 0, 0xc0c0c0, 0, 0xd6d6d6, 0, 0xececec, 0,
   0x484800, 0, 0x69690f, 0, 0x86861d, 0, 0xa2a22a, 0,
@@ -880,7 +949,7 @@ uInt32 Console::ourNTSCPalette[256] = {
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Console::ourPALPalette[256] = {
+const uInt32 Console::ourPALPalette[256] = {
   0x000000, 0, 0x2b2b2b, 0, 0x525252, 0, 0x767676, 0,
   0x979797, 0, 0xb6b6b6, 0, 0xd2d2d2, 0, 0xececec, 0,
   0x000000, 0, 0x2b2b2b, 0, 0x525252, 0, 0x767676, 0,
@@ -916,7 +985,7 @@ uInt32 Console::ourPALPalette[256] = {
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Console::ourSECAMPalette[256] = {
+const uInt32 Console::ourSECAMPalette[256] = {
   0x000000, 0, 0x2121ff, 0, 0xf03c79, 0, 0xff50ff, 0, 
   0x7fff00, 0, 0x7fffff, 0, 0xffff3f, 0, 0xffffff, 0, 
   0x000000, 0, 0x2121ff, 0, 0xf03c79, 0, 0xff50ff, 0, 
@@ -952,7 +1021,7 @@ uInt32 Console::ourSECAMPalette[256] = {
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Console::ourNTSCPaletteZ26[256] = {
+const uInt32 Console::ourNTSCPaletteZ26[256] = {
   0x000000, 0, 0x505050, 0, 0x646464, 0, 0x787878, 0,
   0x8c8c8c, 0, 0xa0a0a0, 0, 0xb4b4b4, 0, 0xc8c8c8, 0,
   0x445400, 0, 0x586800, 0, 0x6c7c00, 0, 0x809000, 0,
@@ -988,7 +1057,7 @@ uInt32 Console::ourNTSCPaletteZ26[256] = {
 }; 
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Console::ourPALPaletteZ26[256] = {
+const uInt32 Console::ourPALPaletteZ26[256] = {
   0x000000, 0, 0x4c4c4c, 0, 0x606060, 0, 0x747474, 0,
   0x888888, 0, 0x9c9c9c, 0, 0xb0b0b0, 0, 0xc4c4c4, 0,
   0x000000, 0, 0x4c4c4c, 0, 0x606060, 0, 0x747474, 0,
@@ -1024,7 +1093,7 @@ uInt32 Console::ourPALPaletteZ26[256] = {
 }; 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Console::ourSECAMPaletteZ26[256] = {
+const uInt32 Console::ourSECAMPaletteZ26[256] = {
   0x000000, 0, 0x2121ff, 0, 0xf03c79, 0, 0xff3cff, 0, 
   0x7fff00, 0, 0x7fffff, 0, 0xffff3f, 0, 0xffffff, 0, 
   0x000000, 0, 0x2121ff, 0, 0xf03c79, 0, 0xff3cff, 0, 
@@ -1059,15 +1128,6 @@ uInt32 Console::ourSECAMPaletteZ26[256] = {
   0x7fff00, 0, 0x7fffff, 0, 0xffff3f, 0, 0xffffff, 0
 };
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Console::ourUserNTSCPalette[256]  = { 0 }; // filled from external file
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Console::ourUserPALPalette[256]   = { 0 }; // filled from external file
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 Console::ourUserSECAMPalette[256] = { 0 }; // filled from external file
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Console::Console(const Console& console)
   : myOSystem(console.myOSystem)
@@ -149,6 +149,45 @@ class Console : public Serializable
     */
     bool load(Deserializer& in);
 
+    /**
+      Answers the number of bytes needed to hold a snapshot of the state
+      of this console, as taken by cloneState().
+
+      @return The size of the state snapshot
+    */
+    uInt32 stateSize() const;
+
+    /**
+      Copies the complete emulation state (CPU, RIOT, TIA, cartridge and
+      switches) to the given buffer.  Unlike save(), this is a raw snapshot
+      which is only meaningful to this console in this process, and is
+      intended for run-ahead, netplay rollback and similar uses where the
+      state is taken and restored many times per frame.
+
+      @param state  The buffer of stateSize() bytes to copy the state to
+      @return  A hash of the snapshot (see stateHash())
+    */
+    uInt64 cloneState(uInt8* state) const;
+
+    /**
+      Restores the complete emulation state from a snapshot which was
+      previously taken by cloneState() on this console.  The sound device
+      is left alone.
+
+      @param state  The buffer to restore the state from
+    */
+    void restoreState(const uInt8* state);
+
+    /**
+      Answers a 64-bit hash of the given snapshot, which is cheap enough to
+      be used for per-frame desync checks.
+
+      @param state  The snapshot to hash
+      @param size   The size of the snapshot (as returned by stateSize())
+      @return  The hash of the snapshot
+    */
+    static uInt64 stateHash(const uInt8* state, uInt32 size);
+
     /**
       Get a descriptor for this console class (used in error checking).
 
@@ -195,6 +234,15 @@ class Console : public Serializable
     */
     void setPalette(const string& palette);
 
+    /**
+      Get the palette which setPalette() would use for the given palette
+      name and the current display format.
+
+      @param palette  The palette name ('standard', 'z26' or 'user')
+      @return  The 256 RGB entries of the palette
+    */
+    const uInt32* palette(const string& palette) const;
+
     /**
       Toggles phosphor effect.
     */
@@ -264,6 +312,18 @@ class Console : public Serializable
     void togglePFBit() const { toggleTIABit(TIA::PF, "PF"); }
     void enableBits(bool enable) const;
 
+    /**
+      Sets the mouse to emulate the given paddle (0 - 3), for any paddles
+      plugged into the console.
+    */
+    void setPaddleMode(int number);
+
+    /**
+      Sets the speed for digital emulation of paddle movement, for any
+      paddles plugged into the console.
+    */
+    void setPaddleSpeed(int speed);
+
     // TODO - make the core code work without needing to access this
     AtariVox* atariVox() { return myAVox; }
 
@@ -337,20 +397,22 @@ class Console : public Serializable
     // Contains detailed info about this console
     ConsoleInfo myConsoleInfo;
 
+    // Tables of RGB values for NTSC, PAL and SECAM (indexed by palette
+    // type, then display format); the standard and z26 versions are
+    // copied from the tables below, and the user-defined version is
+    // loaded from a file
+    // Each console has its own copy, since color-loss changes them
+    uInt32 myPalettes[3][3][256];
+
     // Table of RGB values for NTSC, PAL and SECAM
-    static uInt32 ourNTSCPalette[256];
-    static uInt32 ourPALPalette[256];
-    static uInt32 ourSECAMPalette[256];
+    static const uInt32 ourNTSCPalette[256];
+    static const uInt32 ourPALPalette[256];
+    static const uInt32 ourSECAMPalette[256];
 
     // Table of RGB values for NTSC, PAL and SECAM - Z26 version
-    static uInt32 ourNTSCPaletteZ26[256];
-    static uInt32 ourPALPaletteZ26[256];
-    static uInt32 ourSECAMPaletteZ26[256];
-
-    // Table of RGB values for NTSC, PAL and SECAM - user-defined
-    static uInt32 ourUserNTSCPalette[256];
-    static uInt32 ourUserPALPalette[256];
-    static uInt32 ourUserSECAMPalette[256];
+    static const uInt32 ourNTSCPaletteZ26[256];
+    static const uInt32 ourPALPaletteZ26[256];
+    static const uInt32 ourSECAMPaletteZ26[256];
 };
 
 #endif
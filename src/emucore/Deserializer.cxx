@@ -16,10 +16,15 @@
 // $Id: Deserializer.cxx,v 1.15 2009-01-01 18:13:35 stephena Exp $
 //============================================================================
 
+#include <cstring>
+
 #include "Deserializer.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Deserializer::Deserializer(void)
+  : myBuffer(0),
+    myBufferSize(0),
+    myBufferPos(0)
 {
 }
 
@@ -38,27 +43,36 @@ bool Deserializer::open(const string& fileName)
   return isOpen();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Deserializer::openBuffer(const uInt8* data, uInt32 size)
+{
+  close();
+  myBuffer = data;
+  myBufferSize = size;
+  myBufferPos = 0;
+
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Deserializer::close(void)
 {
   myStream.close();
   myStream.clear();
+  myBuffer = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Deserializer::isOpen(void)
 {
-  return myStream.is_open();
+  return myBuffer != 0 || myStream.is_open();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 char Deserializer::getByte(void)
 {
-  if(myStream.eof())
-    throw "Deserializer: end of file";
-
   char buf[1];
-  myStream.read(buf, 1);
+  read(buf, 1);
 
   return buf[0];
 }
@@ -66,12 +80,9 @@ char Deserializer::getByte(void)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int Deserializer::getInt(void)
 {
-  if(myStream.eof())
-    throw "Deserializer: end of file";
-
   int val = 0;
   unsigned char buf[4];
-  myStream.read((char*)buf, 4);
+  read(buf, 4);
   for(int i = 0; i < 4; ++i)
     val += (int)(buf[i]) << (i<<3);
 
@@ -82,12 +93,13 @@ int Deserializer::getInt(void)
 string Deserializer::getString(void)
 {
   int len = getInt();
+  if(len < 0)
+    throw "Deserializer: data corruption";
+
   string str;
   str.resize((string::size_type)len);
-  myStream.read(&str[0], (streamsize)len);
-
-  if(myStream.bad())
-    throw "Deserializer: file read failed";
+  if(len > 0)
+    read(&str[0], len);
 
   return str;
 }
@@ -107,3 +119,25 @@ bool Deserializer::getBool(void)
 
   return result;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Deserializer::read(void* data, uInt32 length)
+{
+  if(myBuffer)
+  {
+    if(length > myBufferSize - myBufferPos)
+      throw "Deserializer: end of buffer";
+
+    memcpy(data, myBuffer + myBufferPos, length);
+    myBufferPos += length;
+  }
+  else
+  {
+    if(myStream.eof())
+      throw "Deserializer: end of file";
+
+    myStream.read((char*)data, (streamsize)length);
+    if(myStream.bad())
+      throw "Deserializer: file read failed";
+  }
+}
@@ -24,8 +24,8 @@
 
 /**
   This class implements a Deserializer device, whereby data is
-  deserialized from an input binary file in a system-independent
-  way.
+  deserialized from an input binary file (or a memory buffer) in a
+  system-independent way.
 
   All bytes and ints should be cast to their appropriate data type upon
   method return.
@@ -39,8 +39,8 @@ class Deserializer
     /**
       Creates a new Deserializer device.
 
-      Open must be called with a valid file before this Deserializer can
-      be used.
+      Open must be called with a valid file (or openBuffer must be called)
+      before this Deserializer can be used.
     */
     Deserializer(void);
 
@@ -59,6 +59,16 @@ class Deserializer
     */
     bool open(const string& fileName);
 
+    /**
+      Opens the given memory buffer for input.  The data isn't copied, so
+      it must remain valid until this Deserializer is closed.
+
+      @param data  The data to get the deserialized data from
+      @param size  The number of bytes of data
+      @return Result of opening the buffer (always true)
+    */
+    bool openBuffer(const uInt8* data, uInt32 size);
+
     /**
       Closes the current input stream.
     */
@@ -97,10 +107,20 @@ class Deserializer
     */
     bool getBool(void);
 
+  private:
+    // Get the given number of bytes from the input stream or buffer
+    void read(void* data, uInt32 length);
+
   private:
     // The stream to get the deserialized data from.
     fstream myStream;
 
+    // The memory buffer to get the deserialized data from, used instead
+    // of the stream when opened with openBuffer()
+    const uInt8* myBuffer;
+    uInt32 myBufferSize;
+    uInt32 myBufferPos;
+
     enum {
       TruePattern  = 0xfe,
       FalsePattern = 0x01
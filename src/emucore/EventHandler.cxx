@@ -30,11 +30,7 @@
 #include "Launcher.hxx"
 #include "Menu.hxx"
 #include "OSystem.hxx"
-#include "Joystick.hxx"
-#include "Paddles.hxx"
 #include "PropsSet.hxx"
-#include "ListWidget.hxx"
-#include "ScrollBarWidget.hxx"
 #include "Settings.hxx"
 #include "Snapshot.hxx"
 #include "Sound.hxx"
@@ -71,11 +67,18 @@ EventHandler::EventHandler(OSystem* osystem)
     myState(S_NONE),
     myGrabMouseFlag(false),
     myAllowAllDirectionsFlag(false),
-    myFryingFlag(false)
+    myFryingFlag(false),
+    myJoyDeadZone(3200)
 {
   // Create the event object which will be used for this handler
   myEvent = new Event();
 
+  // Each handler labels the actions with its own key mappings
+  for(int i = 0; i < kEmulActionListSize; ++i)
+    myEmulActionList[i] = ourEmulActionList[i];
+  for(int i = 0; i < kMenuActionListSize; ++i)
+    myMenuActionList[i] = ourMenuActionList[i];
+
   // Erase the key mapping array
   for(int i = 0; i < SDLK_LAST; ++i)
   {
@@ -123,11 +126,11 @@ EventHandler::~EventHandler()
 {
   // Free strings created with strdup
   for(uInt32 i = 0; i < kEmulActionListSize; ++i)
-    if(ourEmulActionList[i].key)
-      free(ourEmulActionList[i].key);
+    if(myEmulActionList[i].key)
+      free(myEmulActionList[i].key);
   for(uInt32 i = 0; i < kMenuActionListSize; ++i)
-    if(ourMenuActionList[i].key)
-      free(ourMenuActionList[i].key);
+    if(myMenuActionList[i].key)
+      free(myMenuActionList[i].key);
 
   delete myEvent;
 
@@ -160,14 +163,7 @@ void EventHandler::initialize()
 
   myGrabMouseFlag = myOSystem->settings().getBool("grabmouse");
 
-  Joystick::setDeadZone(myOSystem->settings().getInt("joydeadzone"));
-  Paddles::setDigitalSpeed(myOSystem->settings().getInt("pspeed"));
-
-  // Set quick select delay when typing characters in listwidgets
-  ListWidget::setQuickSelectDelay(myOSystem->settings().getInt("listdelay"));
-
-  // Set number of lines a mousewheel will scroll
-  ScrollBarWidget::setWheelLines(myOSystem->settings().getInt("mwheel"));
+  setJoyDeadZone(myOSystem->settings().getInt("joydeadzone"));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -336,7 +332,7 @@ void EventHandler::handleWiiJoyAxisEvents( const int joyIndex, const int wiiJoyI
     s8 gcX = PAD_StickX( wiiJoyIndex );
     s8 gcY = PAD_StickY( wiiJoyIndex );
 
-    int deadzone = Joystick::deadzone();
+    int deadzone = myJoyDeadZone;
 
     if( held & ( WII_BUTTON_ATARI_UP | ( isClassic ? WII_CLASSIC_ATARI_UP : 0 ) ) || 
         gcHeld & GC_BUTTON_ATARI_UP || 
@@ -833,6 +829,13 @@ void EventHandler::poll(uInt32 time)
               case SDLK_l:
                 myOSystem->frameBuffer().toggleFrameStats();
                 break;
+
+              case SDLK_r:  // Alt-r starts/stops rewind mode
+                if(myOSystem->state().toggleRewindMode())
+                  myOSystem->frameBuffer().showMessage("Rewind mode started");
+                else
+                  myOSystem->frameBuffer().showMessage("Rewind mode stopped");
+                break;
 #if 0
 // FIXME - these will be removed when a UI is added for event recording
               case SDLK_e:  // Alt-e starts/stops event recording
@@ -842,11 +845,11 @@ void EventHandler::poll(uInt32 time)
                   myOSystem->frameBuffer().showMessage("Recording stopped");
                 break;
 
-              case SDLK_r:  // Alt-r starts/stops rewind mode
-                if(myOSystem->state().toggleRewindMode())
-                  myOSystem->frameBuffer().showMessage("Rewind mode started");
+              case SDLK_y:  // Alt-y starts/stops movie playback
+                if(myOSystem->state().togglePlaybackMode())
+                  myOSystem->frameBuffer().showMessage("Playback started");
                 else
-                  myOSystem->frameBuffer().showMessage("Rewind mode stopped");
+                  myOSystem->frameBuffer().showMessage("Playback stopped");
                 break;
 /*
               case SDLK_l:  // Alt-l loads a recording
@@ -1305,7 +1308,7 @@ void EventHandler::handleJoyAxisEvent(int stick, int axis, int value)
     default:
     {
       // Otherwise, we know the event is digital
-      int deadzone = Joystick::deadzone();
+      int deadzone = myJoyDeadZone;
       if(value > -deadzone && value < deadzone)
       {
         // Turn off both events, since we don't know exactly which one
@@ -1400,6 +1403,19 @@ void EventHandler::handleEvent(Event::Type event, int state)
       myFryingFlag = bool(state);
       return;
 
+    case Event::TurboMode:
+      if(state)
+      {
+        myOSystem->setTurbo(!myOSystem->turbo());
+        myOSystem->frameBuffer().showMessage(myOSystem->turbo() ?
+          "Fast-forward enabled" : "Fast-forward disabled");
+      }
+      return;
+
+    case Event::Rewind:
+      if(state) myOSystem->state().rewindState();
+      return;
+
     case Event::VolumeDecrease:
       if(state) myOSystem->sound().adjustVolume(-1);
       return;
@@ -1522,11 +1538,11 @@ void EventHandler::setActionMappings(EventMode mode)
   {
     case kEmulationMode:
       listsize = kEmulActionListSize;
-      list     = ourEmulActionList;
+      list     = myEmulActionList;
       break;
     case kMenuMode:
       listsize = kMenuActionListSize;
-      list     = ourMenuActionList;
+      list     = myMenuActionList;
       break;
     default:
       return;
@@ -1976,6 +1992,8 @@ void EventHandler::setDefaultKeymap(EventMode mode)
       myKeyTable[ SDLK_F11 ][mode]       = Event::LoadState;
       myKeyTable[ SDLK_F12 ][mode]       = Event::TakeSnapshot;
       myKeyTable[ SDLK_BACKSPACE ][mode] = Event::Fry;
+      myKeyTable[ SDLK_EQUALS ][mode]    = Event::TurboMode;
+      myKeyTable[ SDLK_MINUS ][mode]     = Event::Rewind;
       myKeyTable[ SDLK_PAUSE ][mode]     = Event::PauseMode;
       myKeyTable[ SDLK_TAB ][mode]       = Event::MenuMode;
       myKeyTable[ SDLK_BACKSLASH ][mode] = Event::CmdMenuMode;
@@ -2150,11 +2168,11 @@ StringList EventHandler::getActionList(EventMode mode)
   {
     case kEmulationMode:
       for(int i = 0; i < kEmulActionListSize; ++i)
-        l.push_back(EventHandler::ourEmulActionList[i].action);
+        l.push_back(myEmulActionList[i].action);
       break;
     case kMenuMode:
       for(int i = 0; i < kMenuActionListSize; ++i)
-        l.push_back(EventHandler::ourMenuActionList[i].action);
+        l.push_back(myMenuActionList[i].action);
       break;
     default:
       break;
@@ -2172,13 +2190,13 @@ Event::Type EventHandler::eventAtIndex(int idx, EventMode mode)
       if(idx < 0 || idx >= kEmulActionListSize)
         return Event::NoType;
       else
-        return ourEmulActionList[idx].event;
+        return myEmulActionList[idx].event;
       break;
     case kMenuMode:
       if(idx < 0 || idx >= kMenuActionListSize)
         return Event::NoType;
       else
-        return ourMenuActionList[idx].event;
+        return myMenuActionList[idx].event;
       break;
     default:
       return Event::NoType;
@@ -2195,13 +2213,13 @@ string EventHandler::actionAtIndex(int idx, EventMode mode)
       if(idx < 0 || idx >= kEmulActionListSize)
         return EmptyString;
       else
-        return ourEmulActionList[idx].action;
+        return myEmulActionList[idx].action;
       break;
     case kMenuMode:
       if(idx < 0 || idx >= kMenuActionListSize)
         return EmptyString;
       else
-        return ourMenuActionList[idx].action;
+        return myMenuActionList[idx].action;
       break;
     default:
       return EmptyString;
@@ -2218,13 +2236,13 @@ string EventHandler::keyAtIndex(int idx, EventMode mode)
       if(idx < 0 || idx >= kEmulActionListSize)
         return EmptyString;
       else
-        return ourEmulActionList[idx].key;
+        return myEmulActionList[idx].key;
       break;
     case kMenuMode:
       if(idx < 0 || idx >= kMenuActionListSize)
         return EmptyString;
       else
-        return ourMenuActionList[idx].key;
+        return myMenuActionList[idx].key;
       break;
     default:
       return EmptyString;
@@ -2293,9 +2311,9 @@ void EventHandler::takeSnapshot()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void EventHandler::setPaddleMode(int num, bool showmessage)
 {
-  if(num >= 0 && num <= 3)
+  if(num >= 0 && num <= 3 && &myOSystem->console())
   {
-    Paddles::setMouseIsPaddle(num);
+    myOSystem->console().setPaddleMode(num);
     if(showmessage)
     {
       ostringstream buf;
@@ -2305,6 +2323,15 @@ void EventHandler::setPaddleMode(int num, bool showmessage)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void EventHandler::setJoyDeadZone(int deadzone)
+{
+  if(deadzone < 0)  deadzone = 0;
+  if(deadzone > 29) deadzone = 29;
+
+  myJoyDeadZone = 3200 + deadzone * 1000;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void EventHandler::enterMenuMode(State state)
 {
@@ -2660,7 +2687,7 @@ void EventHandler::setSDLMappings()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-EventHandler::ActionList EventHandler::ourEmulActionList[kEmulActionListSize] = {
+const EventHandler::ActionList EventHandler::ourEmulActionList[kEmulActionListSize] = {
   { Event::ConsoleSelect,               "Select",                      0 },
   { Event::ConsoleReset,                "Reset",                       0 },
   { Event::ConsoleColor,                "Color TV",                    0 },
@@ -2674,6 +2701,8 @@ EventHandler::ActionList EventHandler::ourEmulActionList[kEmulActionListSize] =
   { Event::LoadState,                   "Load State",                  0 },
   { Event::TakeSnapshot,                "Snapshot",                    0 },
   { Event::Fry,                         "Fry cartridge",               0 },
+  { Event::TurboMode,                   "Toggle fast-forward",         0 },
+  { Event::Rewind,                      "Rewind",                      0 },
   { Event::VolumeDecrease,              "Decrease volume",             0 },
   { Event::VolumeIncrease,              "Increase volume",             0 },
   { Event::PauseMode,                   "Pause",                       0 },
@@ -2747,7 +2776,7 @@ EventHandler::ActionList EventHandler::ourEmulActionList[kEmulActionListSize] =
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-EventHandler::ActionList EventHandler::ourMenuActionList[kMenuActionListSize] = {
+const EventHandler::ActionList EventHandler::ourMenuActionList[kMenuActionListSize] = {
   { Event::UIUp,        "Move Up",              0 },
   { Event::UIDown,      "Move Down",            0 },
   { Event::UILeft,      "Move Left",            0 },
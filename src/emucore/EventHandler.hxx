@@ -194,6 +194,19 @@ class EventHandler
     */
     void setPaddleMode(int num, bool showmessage = false);
 
+    /**
+      Sets the deadzone amount for real analog joysticks.
+
+      @param deadzone  The deadzone, from 0 (the smallest) to 29
+    */
+    void setJoyDeadZone(int deadzone);
+
+    /**
+      Answers the axis value below which real analog joysticks are
+      considered to be centered.
+    */
+    int joyDeadZone() const { return myJoyDeadZone; }
+
     inline bool kbdAlt(int mod)
     {
   #ifndef MAC_OSX
@@ -417,7 +430,7 @@ class EventHandler
 
   private:
     enum {
-      kEmulActionListSize = 75,
+      kEmulActionListSize = 77,
       kMenuActionListSize = 13
     };
 
@@ -502,12 +515,20 @@ class EventHandler
     // Indicates whether or not we're in frying mode
     bool myFryingFlag;
 
+    // The axis value below which analog joysticks are considered centered
+    int myJoyDeadZone;
+
     // Indicates which paddle the mouse currently emulates
     Int8 myPaddleMode;
 
-    // Holds static strings for the remap menu (emulation and menu events)
-    static ActionList ourEmulActionList[kEmulActionListSize];
-    static ActionList ourMenuActionList[kMenuActionListSize];
+    // Holds strings for the remap menu (emulation and menu events),
+    // including the keys currently mapped to each action
+    ActionList myEmulActionList[kEmulActionListSize];
+    ActionList myMenuActionList[kMenuActionListSize];
+
+    // The actions for the remap menu, before any keys are mapped
+    static const ActionList ourEmulActionList[kEmulActionListSize];
+    static const ActionList ourMenuActionList[kMenuActionListSize];
 
     // Static lookup tables for Stelladaptor axis/button support
     static const Event::Type SA_Axis[2][2];
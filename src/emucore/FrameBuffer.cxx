@@ -17,12 +17,14 @@
 //============================================================================
 
 #include <algorithm>
+#include <cstring>
 #include <sstream>
 
 #include "bspf.hxx"
 
 #include "CommandMenu.hxx"
 #include "Console.hxx"
+#include "Deserializer.hxx"
 #include "EventHandler.hxx"
 #include "Event.hxx"
 #include "Font.hxx"
@@ -30,12 +32,16 @@
 #include "Menu.hxx"
 #include "OSystem.hxx"
 #include "Settings.hxx"
+#include "Sound.hxx"
+#include "SoundStats.hxx"
 #include "TIA.hxx"
 
 #include "FrameBuffer.hxx"
 
 #ifdef DEBUGGER_SUPPORT
   #include "Debugger.hxx"
+  #include "M6502.hxx"
+  #include "System.hxx"
 #endif
 
 #ifdef WII
@@ -43,6 +49,21 @@
 #include "wii_main.hxx"
 #endif
 
+/**
+  Emulates the frames for the pipeline, on its thread.
+*/
+class FrameBuffer::PipelineProducer : public FramePipeline::Producer
+{
+  public:
+    PipelineProducer(FrameBuffer& framebuffer) : myFrameBuffer(framebuffer) { }
+
+    bool produceFrame(FramePipeline::Frame& frame, bool draw)
+      { return myFrameBuffer.produceFrame(frame, draw); }
+
+  private:
+    FrameBuffer& myFrameBuffer;
+};
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 FrameBuffer::FrameBuffer(OSystem* osystem)
   : myOSystem(osystem),
@@ -52,6 +73,15 @@ FrameBuffer::FrameBuffer(OSystem* osystem)
     myPhosphorBlend(77),
     myInitializedCount(0),
     myPausedCount(0),
+    myFramesSinceDraw(0),
+    myRunAheadFrames(0),
+    myPipeline(0),
+    myPipelineProducer(0),
+    myPresentLateFlag(false),
+    myPresentSkipFlag(false),
+    myPresentSkipCount(0),
+    mySoundLogInterval(0),
+    mySoundLogTime(0),
     mySurfaceCount(0)
 {
   myMsg.surface   = myStatsMsg.surface = NULL;
@@ -62,6 +92,9 @@ FrameBuffer::FrameBuffer(OSystem* osystem)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 FrameBuffer::~FrameBuffer(void)
 {
+  delete myPipeline;
+  delete myPipelineProducer;
+
   // Free all allocated surfaces
   while(!mySurfaceList.empty())
   {
@@ -136,16 +169,45 @@ bool FrameBuffer::initialize(const string& title, uInt32 width, uInt32 height)
   // Erase any messages from a previous run
   myMsg.counter = 0;
 
+  myRunAheadFrames = myOSystem->settings().getInt("runahead");
+
+  // Emulate while drawing, if asked to; frames are the size of the TIA's
+  // own buffers, and any queued for the old screen aren't wanted
+  if(myOSystem->settings().getBool("pipeline"))
+  {
+    if(myPipeline == NULL)
+    {
+      myPipelineProducer = new PipelineProducer(*this);
+      myPipeline = new FramePipeline(*myPipelineProducer, 160 * 300);
+    }
+    myPipeline->reset();
+  }
+  else
+  {
+    delete myPipeline;
+    delete myPipelineProducer;
+    myPipeline = NULL;
+    myPipelineProducer = NULL;
+  }
+
+  mySoundLogInterval = myOSystem->settings().getInt("audiolog") * 1000000;
+  mySoundLogTime = myOSystem->getTicks();
+
   // Create surfaces for TIA statistics and general messages
+  // The statistics have an extra line while pipelining, and are wide
+  // enough for the longest line, the sound summary
   myStatsMsg.color = kBtnTextColor;
-  myStatsMsg.w = myOSystem->consoleFont().getMaxCharWidth() * 21;
-  myStatsMsg.h = (myOSystem->consoleFont().getFontHeight() + 2) * 3;
+  myStatsMsg.w = myOSystem->consoleFont().getMaxCharWidth() * 28;
+  myStatsMsg.h = (myOSystem->consoleFont().getFontHeight() + 2) *
+                 (myPipeline ? 5 : 4);
 
  if(myStatsMsg.surface == NULL)
   {
-    myStatsMsg.surfaceID = allocateSurface(myStatsMsg.w, myStatsMsg.h);
+    myStatsMsg.surfaceID = allocateSurface(myStatsMsg.w,
+      (myOSystem->consoleFont().getFontHeight() + 2) * 5);
     myStatsMsg.surface   = surface(myStatsMsg.surfaceID);
   }
+  myStatsMsg.surface->setHeight(myStatsMsg.h);
   if(myMsg.surface == NULL)
   {
     myMsg.surfaceID = allocateSurface(500, myOSystem->font().getFontHeight()+10);
@@ -165,22 +227,94 @@ extern double current_fps;
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FrameBuffer::update()
 {
+  // Frames in the pipeline are only kept while emulating or paused; in
+  // any other mode the console can be changed behind its back, and it's
+  // the TIA's own buffers that should be shown
+  EventHandler::State state = myOSystem->eventHandler().state();
+  if(myPipeline && state != EventHandler::S_EMULATE &&
+     state != EventHandler::S_PAUSE)
+    myPipeline->reset();
+
+  // Set when a frame is being emulated on the pipeline's thread, and
+  // when the drawing started
+  bool pipelined = false;
+  uInt32 presentStart = 0;
+
   // Determine which mode we are in (from the EventHandler)
   // Take care of S_EMULATE mode here, otherwise let the GUI
   // figure out what to draw
-  switch(myOSystem->eventHandler().state())
+  switch(state)
   {
     case EventHandler::S_EMULATE:
     {
-      // Run the console for one frame
-      // Note that the debugger can cause a breakpoint to occur, which changes
-      // the EventHandler state 'behind our back' - we need to check for that
-      myOSystem->console().tia().update();
+      // In fast-forward mode only some frames are drawn; the TIA doesn't
+      // need to render the others at all
+      if(++myFramesSinceDraw >= myOSystem->framesPerDraw())
+        myFramesSinceDraw = 0;
+      bool draw = (myFramesSinceDraw == 0);
+      bool show = draw;
+
+      if(canPipeline())
+      {
+        // The frame shown now is the one emulated during the last update,
+        // and the next one is emulated on the pipeline's thread while
+        // this one is drawn; the very first frame has to be emulated
+        // before anything can be shown
+        if(myPipeline->current() == NULL)
+        {
+          myPipeline->start(true);
+          myPipeline->finish();
+          myRedrawEntireFrame = true;
+        }
+        show = myPipeline->present();
+
+        if(myOSystem->eventHandler().frying())
+          myOSystem->console().fry();
+
+        // When showing the last frame took longer than a frame lasts, the
+        // next one isn't drawn, so that the screen can catch up; but never
+        // two in a row, so that it never stops moving
+        bool skip = draw && myPresentLateFlag && !myPresentSkipFlag;
+        if(skip)
+          ++myPresentSkipCount;
+        myPresentSkipFlag = skip;
+
+        myPipeline->start(draw && !skip);
+        pipelined = true;
+        presentStart = myOSystem->getTicks();
+      }
+      else
+      {
+        // The pipeline's frames are stale once the console runs here
+        if(myPipeline && myPipeline->current())
+        {
+          myPipeline->reset();
+          myRedrawEntireFrame = true;
+        }
+
+        // Run the console for one frame
+        // Note that the debugger can cause a breakpoint to occur, which changes
+        // the EventHandler state 'behind our back' - we need to check for that
+        emulateFrame(draw);
   #ifdef DEBUGGER_SUPPORT
-      if(myOSystem->eventHandler().state() != EventHandler::S_EMULATE) break;
+        if(myOSystem->eventHandler().state() != EventHandler::S_EMULATE) break;
   #endif
-      if(myOSystem->eventHandler().frying())
-        myOSystem->console().fry();
+        if(myOSystem->eventHandler().frying())
+          myOSystem->console().fry();
+      }
+
+      // Log the sound statistics every so often, if asked to
+      if(mySoundLogInterval > 0 &&
+         myOSystem->getTicks() - mySoundLogTime >= mySoundLogInterval)
+      {
+        const SoundStats* stats = myOSystem->sound().stats();
+        if(stats)
+          cout << stats->report() << endl;
+        mySoundLogTime = myOSystem->getTicks();
+      }
+
+      if(!show)
+        break;
 
       // And update the screen
       drawTIA(myRedrawEntireFrame);
@@ -194,23 +328,47 @@ void FrameBuffer::update()
 #endif
       {
         const ConsoleInfo& info = myOSystem->console().about();
-        char msg[30];
+        uInt32 scanlines = pipelined ? myPipeline->current()->scanlines :
+                           myOSystem->console().tia().scanlines();
+        char msg[40];
 #ifndef WII
         sprintf(msg, "%u LINES  %2.2f FPS",
-                myOSystem->console().tia().scanlines(),
-                myOSystem->console().getFramerate());
+                scanlines, myOSystem->console().getFramerate());
 #else
         sprintf(msg, "%u LINES  %2.2f FPS",
-                myOSystem->console().tia().scanlines(),
-                current_fps);
+                scanlines, current_fps);
 #endif
         myStatsMsg.surface->fillRect(0, 0, myStatsMsg.w, myStatsMsg.h, kBGColor);
         myStatsMsg.surface->drawString(&myOSystem->consoleFont(),
           msg, 1, 1, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
+        // With run-ahead, also show how much sooner the frames appear
+        string format = info.DisplayFormat;
+        if(myRunAheadFrames > 0)
+        {
+          sprintf(msg, "%s  -%uF %uMS", info.DisplayFormat.c_str(),
+                  myRunAheadFrames, (uInt32) (myRunAheadFrames * 1000.0 /
+                  myOSystem->console().getFramerate() + 0.5));
+          format = msg;
+        }
         myStatsMsg.surface->drawString(&myOSystem->consoleFont(),
-          info.DisplayFormat, 1, 15, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
+          format, 1, 15, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
         myStatsMsg.surface->drawString(&myOSystem->consoleFont(),
           info.BankSwitch, 1, 30, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
+        // Latency, underruns, dropped writes and jitter of the sound
+        const SoundStats* stats = myOSystem->sound().stats();
+        if(stats)
+          myStatsMsg.surface->drawString(&myOSystem->consoleFont(),
+            stats->summary(), 1, 45, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
+        // The frame of delay added by pipelining, and the frames which
+        // weren't drawn because of it
+        if(myPipeline)
+        {
+          sprintf(msg, "PIPE +1F %uMS S%u", (uInt32) (1000.0 /
+                  myOSystem->console().getFramerate() + 0.5),
+                  myPresentSkipCount);
+          myStatsMsg.surface->drawString(&myOSystem->consoleFont(),
+            msg, 1, 60, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
+        }
         myStatsMsg.surface->addDirtyRect(0, 0, 0, 0);  // force a full draw
         myStatsMsg.surface->setPos(myImageRect.x() + 3, myImageRect.y() + 3);
         myStatsMsg.surface->update();
@@ -289,6 +447,108 @@ void FrameBuffer::update()
 #ifdef WII
   }
 #endif
+
+  // Wait for the next frame, so that the console is left alone between
+  // updates, and note whether showing this one took too long
+  if(pipelined)
+  {
+    myPresentLateFlag = myOSystem->getTicks() - presentStart >
+                        (uInt32) (1000000.0 / myOSystem->frameRate());
+    myPipeline->finish();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FrameBuffer::emulateFrame(bool draw)
+{
+  Console& console = myOSystem->console();
+  TIA& tia = console.tia();
+
+  // The frame which really happens is never the one shown when running
+  // ahead, but it's the only one which is heard
+  tia.enableRendering(draw && myRunAheadFrames == 0);
+  tia.update();
+  tia.enableRendering(true);
+  if(!draw || myRunAheadFrames == 0 ||
+     myOSystem->eventHandler().state() != EventHandler::S_EMULATE)
+    return;
+
+  myRunAheadState.openBuffer();
+  if(!console.save(myRunAheadState))
+    return;
+
+  // Note that a breakpoint may be hit in one of these frames, in which
+  // case it's abandoned and the debugger sees the state from before it
+  tia.enableSound(false);
+  for(uInt32 i = 1; i <= myRunAheadFrames; ++i)
+  {
+    tia.enableRendering(i == myRunAheadFrames);
+    tia.update();
+    if(myOSystem->eventHandler().state() != EventHandler::S_EMULATE)
+      break;
+  }
+
+  // Loading a state turns all the TIA objects back on, so the ones the
+  // user has hidden are hidden again afterwards
+  bool enabled[6];
+  for(uInt32 b = 0; b < 6; ++b)
+    enabled[b] = tia.bitEnabled((TIA::TIABit) b);
+
+  Deserializer in;
+  in.openBuffer(myRunAheadState.buffer(), myRunAheadState.bufferSize());
+  if(!console.load(in))
+    cerr << "ERROR: Couldn't restore state after running ahead" << endl;
+  for(uInt32 b = 0; b < 6; ++b)
+    tia.enableBit((TIA::TIABit) b, enabled[b]);
+  tia.enableSound(true);
+  tia.enableRendering(true);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FrameBuffer::canPipeline() const
+{
+  if(myPipeline == NULL)
+    return false;
+
+#ifdef DEBUGGER_SUPPORT
+  // A breakpoint or trap would start the debugger on the wrong thread
+  if(myOSystem->console().system().m6502().debuggerHooksInstalled())
+    return false;
+#endif
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FrameBuffer::produceFrame(FramePipeline::Frame& frame, bool draw)
+{
+  emulateFrame(draw);
+  if(!draw)
+    return false;
+
+  const TIA& tia = myOSystem->console().tia();
+  memcpy(frame.pixels, tia.currentFrameBuffer(), tia.width() * tia.height());
+  frame.scanlines = tia.scanlines();
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8* FrameBuffer::currentFrameBuffer() const
+{
+  if(myPipeline && myPipeline->current())
+    return myPipeline->current()->pixels;
+
+  return myOSystem->console().tia().currentFrameBuffer();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8* FrameBuffer::previousFrameBuffer() const
+{
+  if(myPipeline && myPipeline->previous())
+    return myPipeline->previous()->pixels;
+
+  return myOSystem->console().tia().previousFrameBuffer();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -532,8 +792,8 @@ void FrameBuffer::resetSurfaces()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 FrameBuffer::tiaPixel(uInt32 idx) const
 {
-  uInt8 c = *(myOSystem->console().tia().currentFrameBuffer() + idx);
-  uInt8 p = *(myOSystem->console().tia().previousFrameBuffer() + idx);
+  uInt8 c = *(currentFrameBuffer() + idx);
+  uInt8 p = *(previousFrameBuffer() + idx);
 
   return (!myUsePhosphor ? myDefPalette[c] : myAvgPalette[c][p]);
 }
@@ -32,7 +32,9 @@ namespace GUI {
 }
 
 #include "EventHandler.hxx"
+#include "FramePipeline.hxx"
 #include "Settings.hxx"
+#include "Serializer.hxx"
 #include "Rect.hxx"
 #include "bspf.hxx"
 
@@ -404,6 +406,14 @@ class FrameBuffer
     */
     void resetSurfaces();
 
+    /**
+      Answers the TIA frame to be drawn, and the one drawn before it.
+      These are the TIA's own buffers, except while the frames are being
+      pipelined, when the TIA is already working on the next frame.
+    */
+    uInt8* currentFrameBuffer() const;
+    uInt8* previousFrameBuffer() const;
+
   protected:
 #ifdef WII
     // Our logical palette (for 8bpp mode)
@@ -484,6 +494,36 @@ class FrameBuffer
     */
     VideoMode getSavedVidMode();
 
+    /**
+      Emulate one frame of the console.  When run-ahead is enabled and the
+      frame is to be drawn, the frame is emulated without being drawn,
+      the state is saved, and more frames are emulated with the current
+      input (silently, and drawing only the last one), after which the
+      state is restored.  What ends up on screen is then the frame which
+      would be shown that many frames from now, so games which take a
+      frame or more to react to their input appear to react sooner.
+
+      @param draw  Whether the frame will be drawn
+    */
+    void emulateFrame(bool draw);
+
+    /**
+      Answer whether this frame can be emulated on the pipeline's thread,
+      which isn't possible when the debugger may be entered from it.
+    */
+    bool canPipeline() const;
+
+    /**
+      Emulate one frame on the pipeline's thread, and copy it to the
+      given buffer if it's to be drawn.
+
+      @param frame  The buffer for the frame
+      @param draw   Whether the frame will be drawn
+
+      @return  True if the frame was drawn
+    */
+    bool produceFrame(FramePipeline::Frame& frame, bool draw);
+
   private:
     /**
       This class implements an iterator around an array of VideoMode objects.
@@ -523,6 +563,34 @@ class FrameBuffer
     // Used to set intervals between messages while in pause mode
     uInt32 myPausedCount;
 
+    // Number of frames emulated since the last one was drawn (only
+    // non-zero in fast-forward mode)
+    uInt32 myFramesSinceDraw;
+
+    // Number of frames to run ahead of the console, and the place
+    // the console state is saved to while doing so
+    uInt32 myRunAheadFrames;
+    Serializer myRunAheadState;
+
+    // Emulates frames on a thread of its own while they're drawn, when
+    // enabled, and feeds it the frames to emulate
+    class PipelineProducer;
+    friend class PipelineProducer;
+    FramePipeline* myPipeline;
+    PipelineProducer* myPipelineProducer;
+
+    // Whether the last frame took longer to show than a frame lasts, and
+    // whether the frame after it wasn't drawn because of that (and how
+    // often that has happened)
+    bool myPresentLateFlag;
+    bool myPresentSkipFlag;
+    uInt32 myPresentSkipCount;
+
+    // Time between logs of the sound statistics (0 for none), and when
+    // they were last logged (both in microseconds)
+    uInt32 mySoundLogInterval;
+    uInt32 mySoundLogTime;
+
     // Dimensions of the actual image, after zooming, and taking into account
     // any image 'centering'
     GUI::Rect myImageRect;
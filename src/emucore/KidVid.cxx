@@ -155,7 +155,7 @@ void KidVid::openSampleFile()
   static const char* kvNameTable[6] = {
     "KVS3.WAV", "KVS1.WAV", "KVS2.WAV", "KVB3.WAV", "KVB1.WAV", "KVB2.WAV"
   };
-  static uInt32 StartSong[6] = {
+  static const uInt32 StartSong[6] = {
     44+38, 0, 44, 44+38+42+62+80, 44+38+42, 44+38+42+62
   };
 
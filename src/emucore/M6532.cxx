@@ -17,6 +17,7 @@
 //============================================================================
 
 #include <cassert>
+#include <cstring>
 #include <iostream>
 
 #include "Console.hxx"
@@ -32,7 +33,6 @@
 M6532::M6532(const Console& console)
   : myConsole(console)
 {
-  reset();
 }
  
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -43,7 +43,7 @@ M6532::~M6532()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6532::reset()
 {
-  class Random random;
+  Random& random = mySystem->randGenerator();
 
   // Randomize the 128 bytes of memory
   for(uInt32 t = 0; t < 128; ++t)
@@ -380,6 +380,61 @@ bool M6532::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The device state copied by cloneState()
+struct M6532State
+{
+  uInt8 RAM[128];
+  uInt32 timer;
+  uInt32 intervalShift;
+  Int32 cyclesWhenTimerSet;
+  bool interruptEnabled;
+  bool interruptTriggered;
+  uInt8 DDRA, DDRB, outA;
+  uInt8 outTimer[4];
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 M6532::stateSize() const
+{
+  return sizeof(M6532State);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 M6532::cloneState(uInt8* state) const
+{
+  M6532State s;
+  memset(&s, 0, sizeof(s));  // the padding is hashed too
+  memcpy(s.RAM, myRAM, 128);
+  s.timer = myTimer;
+  s.intervalShift = myIntervalShift;
+  s.cyclesWhenTimerSet = myCyclesWhenTimerSet;
+  s.interruptEnabled = myInterruptEnabled;
+  s.interruptTriggered = myInterruptTriggered;
+  s.DDRA = myDDRA;  s.DDRB = myDDRB;  s.outA = myOutA;
+  memcpy(s.outTimer, myOutTimer, 4);
+  memcpy(state, &s, sizeof(s));
+
+  return sizeof(s);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 M6532::restoreState(const uInt8* state)
+{
+  M6532State s;
+  memcpy(&s, state, sizeof(s));
+  memcpy(myRAM, s.RAM, 128);
+  myTimer = s.timer;
+  myIntervalShift = s.intervalShift;
+  myCyclesWhenTimerSet = s.cyclesWhenTimerSet;
+  myInterruptEnabled = s.interruptEnabled;
+  myInterruptTriggered = s.interruptTriggered;
+  myDDRA = s.DDRA;  myDDRB = s.DDRB;  myOutA = s.outA;
+  memcpy(myOutTimer, s.outTimer, 4);
+
+  return sizeof(s);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 M6532::M6532(const M6532& c)
   : myConsole(c.myConsole)
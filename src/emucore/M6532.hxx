@@ -110,6 +110,31 @@ class M6532 : public Device
     */
     virtual string name() const { return "M6532"; }
 
+    /**
+      Answers the number of bytes used by cloneState().
+
+      @return The size of the state snapshot
+    */
+    uInt32 stateSize() const;
+
+    /**
+      Copies the current state of this device to the given buffer
+      (see Device::cloneState()).
+
+      @param state  The buffer of stateSize() bytes to copy the state to
+      @return  The number of bytes copied (always stateSize())
+    */
+    uInt32 cloneState(uInt8* state) const;
+
+    /**
+      Restores the state of this device from a snapshot which was taken
+      by cloneState().
+
+      @param state  The buffer to restore the state from
+      @return  The number of bytes used from the buffer
+    */
+    uInt32 restoreState(const uInt8* state);
+
    public:
     /**
       Get the byte at the specified address
@@ -126,6 +151,14 @@ class M6532 : public Device
     */
     virtual void poke(uInt16 address, uInt8 value);
 
+    /**
+      Get the 128 bytes of RAM, for tools which inspect or patch the RAM
+      directly rather than through peek/poke
+
+      @return Pointer to the RAM array
+    */
+    uInt8* ram() { return myRAM; }
+
   private:
     inline Int32 timerClocks()
       { return myTimer - (mySystem->cycles() - myCyclesWhenTimerSet); }
@@ -67,7 +67,6 @@
 #include "ConsoleFont.hxx"
 #include "Widget.hxx"
 #include "Console.hxx"
-#include "Random.hxx"
 #include "StateManager.hxx"
 
 #include "OSystem.hxx"
@@ -103,6 +102,9 @@ OSystem::OSystem()
     myCheatManager(NULL),
     myStateManager(NULL),
     myQuitLoop(false),
+    myTurboFlag(false),
+    myTurboSpeed(1),
+    myTurboFrames(1),
     myRomFile(""),
     myRomMD5(""),
     myFeatures(""),
@@ -288,9 +290,6 @@ bool OSystem::create()
   mySerialPort = new SerialPort();
 #endif
 
-  // Let the random class know about us; it needs access to getTicks()
-  Random::setSystem(this);
-
   return true;
 }
 
@@ -379,6 +378,26 @@ void OSystem::setFramerate(float framerate)
   myTimePerFrame = (uInt32)(1000000.0 / myDisplayFrameRate);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::setTurbo(bool enable)
+{
+  myTurboFlag = enable;
+  if(myTurboFlag)
+  {
+    myTurboSpeed  = BSPF_max(mySettings->getInt("turbospeed"), 0);
+    myTurboFrames = BSPF_max(mySettings->getInt("turboframes"), 1);
+  }
+  else
+  {
+    myTurboSpeed  = 1;
+    myTurboFrames = 1;
+  }
+  mySound->setSpeed(myTurboSpeed);
+
+  // The loop timing is either far behind or ahead of real time by now
+  resetLoopTiming();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool OSystem::createFrameBuffer()
 {
@@ -444,6 +463,7 @@ void OSystem::createSound()
 {
   delete mySound;  mySound = NULL;
   mySound = MediaFactory::createAudio(this);
+  mySound->setSpeed(myTurboSpeed);
 #ifndef SOUND_SUPPORT
   mySettings->setBool("sound", false);
 #endif
@@ -610,44 +630,13 @@ string OSystem::MD5FromFile(const string& filename)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Console* OSystem::openConsole(const string& romfile, string& md5)
 {
-#define CMDLINE_PROPS_UPDATE(cl_name, prop_name) \
-  s = mySettings->getString(cl_name);            \
-  if(s != "") props.set(prop_name, s);
-
   Console* console = (Console*) NULL;
 
   // Open the cartridge image and read it in
   uInt8* image = 0;
   uInt32 size  = 0;
   if((image = openROM(romfile, md5, size)) != 0)
-  {
-    // Get a valid set of properties, including any entered on the commandline
-    Properties props;
-    myPropSet->getMD5(md5, props);
-
-    string s = "";
-    CMDLINE_PROPS_UPDATE("bs", Cartridge_Type);
-    CMDLINE_PROPS_UPDATE("type", Cartridge_Type);
-    CMDLINE_PROPS_UPDATE("channels", Cartridge_Sound);
-    CMDLINE_PROPS_UPDATE("ld", Console_LeftDifficulty);
-    CMDLINE_PROPS_UPDATE("rd", Console_RightDifficulty);
-    CMDLINE_PROPS_UPDATE("tv", Console_TelevisionType);
-    CMDLINE_PROPS_UPDATE("sp", Console_SwapPorts);
-    CMDLINE_PROPS_UPDATE("lc", Controller_Left);
-    CMDLINE_PROPS_UPDATE("rc", Controller_Right);
-    s = mySettings->getString("bc");
-    if(s != "") { props.set(Controller_Left, s); props.set(Controller_Right, s); }
-    CMDLINE_PROPS_UPDATE("cp", Controller_SwapPaddles);
-    CMDLINE_PROPS_UPDATE("format", Display_Format);
-    CMDLINE_PROPS_UPDATE("ystart", Display_YStart);
-    CMDLINE_PROPS_UPDATE("height", Display_Height);
-    CMDLINE_PROPS_UPDATE("pp", Display_Phosphor);
-    CMDLINE_PROPS_UPDATE("ppblend", Display_PPBlend);
-
-    Cartridge* cart = Cartridge::create(image, size, props, *mySettings);
-    if(cart)
-      console = new Console(this, cart, props);
-  }
+    console = openConsole(image, size, md5);
   else
     cerr << "ERROR: Couldn't open " << romfile << endl;
 
@@ -658,6 +647,46 @@ Console* OSystem::openConsole(const string& romfile, string& md5)
   return console;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Console* OSystem::openConsole(const uInt8* image, uInt32 size, string& md5)
+{
+#define CMDLINE_PROPS_UPDATE(cl_name, prop_name) \
+  s = mySettings->getString(cl_name);            \
+  if(s != "") props.set(prop_name, s);
+
+  if(md5 == "")
+    md5 = MD5(image, size);
+
+  // Get a valid set of properties, including any entered on the commandline
+  Properties props;
+  myPropSet->getMD5(md5, props);
+
+  string s = "";
+  CMDLINE_PROPS_UPDATE("bs", Cartridge_Type);
+  CMDLINE_PROPS_UPDATE("type", Cartridge_Type);
+  CMDLINE_PROPS_UPDATE("channels", Cartridge_Sound);
+  CMDLINE_PROPS_UPDATE("ld", Console_LeftDifficulty);
+  CMDLINE_PROPS_UPDATE("rd", Console_RightDifficulty);
+  CMDLINE_PROPS_UPDATE("tv", Console_TelevisionType);
+  CMDLINE_PROPS_UPDATE("sp", Console_SwapPorts);
+  CMDLINE_PROPS_UPDATE("lc", Controller_Left);
+  CMDLINE_PROPS_UPDATE("rc", Controller_Right);
+  s = mySettings->getString("bc");
+  if(s != "") { props.set(Controller_Left, s); props.set(Controller_Right, s); }
+  CMDLINE_PROPS_UPDATE("cp", Controller_SwapPaddles);
+  CMDLINE_PROPS_UPDATE("format", Display_Format);
+  CMDLINE_PROPS_UPDATE("ystart", Display_YStart);
+  CMDLINE_PROPS_UPDATE("height", Display_Height);
+  CMDLINE_PROPS_UPDATE("pp", Display_Phosphor);
+  CMDLINE_PROPS_UPDATE("ppblend", Display_PPBlend);
+
+  Cartridge* cart = Cartridge::create(image, size, props, *mySettings);
+  if(cart)
+    return new Console(this, cart, props);
+
+  return (Console*) NULL;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8* OSystem::openROM(const string& file, string& md5, uInt32& size)
 {
@@ -793,6 +822,18 @@ void OSystem::resetLoopTiming()
 #endif
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 OSystem::loopFrameTime(uInt32 timePerFrame) const
+{
+  // Fast-forward only applies to emulation, never to the GUI
+  if(!myTurboFlag || myEventHandler->state() != EventHandler::S_EMULATE)
+    return timePerFrame;
+
+  // When running as fast as possible there's never any waiting; the loop
+  // timing is reset once fast-forward mode is turned off again
+  return myTurboSpeed > 0 ? timePerFrame / myTurboSpeed : 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void OSystem::setDefaultJoymap()
 {
@@ -907,15 +948,15 @@ void OSystem::mainLoop()
 #endif
 
 #ifndef WII
-      myTimingInfo.virt += myTimePerFrame;
+      myTimingInfo.virt += loopFrameTime(myTimePerFrame);
 #else      
       if( wii_force_fps != -1 )
       {
-          myTimingInfo.virt += (1000000.0/wii_force_fps);
+          myTimingInfo.virt += loopFrameTime((uInt32)(1000000.0/wii_force_fps));
       }
       else
       {
-          myTimingInfo.virt += myTimePerFrame;
+          myTimingInfo.virt += loopFrameTime(myTimePerFrame);
       }
 #endif
 
@@ -948,7 +989,7 @@ void OSystem::mainLoop()
       myEventHandler->poll(myTimingInfo.start);
       if(myQuitLoop) break;  // Exit if the user wants to quit
       myFrameBuffer->update();
-      myTimingInfo.virt += myTimePerFrame;
+      myTimingInfo.virt += loopFrameTime(myTimePerFrame);
 
       while(getTicks() < myTimingInfo.virt)
         ;  // busy-wait
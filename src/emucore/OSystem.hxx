@@ -218,6 +218,27 @@ class OSystem
     */
     virtual void setFramerate(float framerate);
 
+    /**
+      Turns fast-forward mode on or off.  While it's on, emulation runs
+      at 'turbospeed' times the normal framerate (or as fast as possible
+      when that's 0), and only one out of every 'turboframes' frames is
+      drawn.
+
+      @param enable  Whether to enable or disable fast-forward mode
+    */
+    void setTurbo(bool enable);
+
+    /**
+      Answers whether fast-forward mode is on.
+    */
+    bool turbo() const { return myTurboFlag; }
+
+    /**
+      Answers how many frames are emulated for every frame which is drawn
+      (always 1 unless fast-forward mode is on).
+    */
+    uInt32 framesPerDraw() const { return myTurboFlag ? myTurboFrames : 1; }
+
     /**
       Set all config file paths for the OSystem.
     */
@@ -318,6 +339,33 @@ class OSystem
     */
     bool createConsole(const string& romfile = "", const string& md5 = "");
 
+    /**
+      Creates an actual Console object based on the given info.  Unlike
+      createConsole(), the console isn't attached to this OSystem, and
+      no video or audio is initialized for it.
+
+      @param romfile  The full pathname of the ROM to use
+      @param md5      The MD5sum of the ROM
+
+      @return  The actual Console object, otherwise NULL
+               (calling method is responsible for deleting it)
+    */
+    Console* openConsole(const string& romfile, string& md5);
+
+    /**
+      Creates an actual Console object from a ROM image which is already
+      in memory (see openConsole() above).  The image is copied, so it
+      may be freed as soon as this returns.
+
+      @param image  The ROM image
+      @param size   The size of the ROM image
+      @param md5    The MD5sum of the ROM (will be calculated if empty)
+
+      @return  The actual Console object, otherwise NULL
+               (calling method is responsible for deleting it)
+    */
+    Console* openConsole(const uInt8* image, uInt32 size, string& md5);
+
     /**
       Deletes the currently defined console, if it exists.
       Also prints some statistics (fps, total frames, etc).
@@ -490,6 +538,11 @@ class OSystem
     // Indicates whether to stop the main loop
     bool myQuitLoop;
 
+    // Fast-forward mode state; see setTurbo()
+    bool myTurboFlag;
+    uInt32 myTurboSpeed;
+    uInt32 myTurboFrames;
+
   private:
     enum { kNumUIPalettes = 2 };
     string myBaseDir, myBaseDirExpanded;
@@ -559,17 +612,6 @@ class OSystem
     */
     void createSound();
 
-    /**
-      Creates an actual Console object based on the given info.
-
-      @param romfile  The full pathname of the ROM to use
-      @param md5      The MD5sum of the ROM
-
-      @return  The actual Console object, otherwise NULL
-               (calling method is responsible for deleting it)
-    */
-    Console* openConsole(const string& romfile, string& md5);
-
     /**
       Open the given ROM and return an array containing its contents.
       Also, the properties database is updated with a valid ROM name
@@ -599,6 +641,14 @@ class OSystem
     */
     void resetLoopTiming();
 
+    /**
+      Get the time the main loop should allow for the next frame, taking
+      fast-forward mode into account.
+
+      @param timePerFrame  The time per frame at normal speed (in usec)
+    */
+    uInt32 loopFrameTime(uInt32 timePerFrame) const;
+
     // Copy constructor isn't supported by this class so make it private
     OSystem(const OSystem&);
 
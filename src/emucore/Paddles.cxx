@@ -29,7 +29,10 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Paddles::Paddles(Jack jack, const Event& event, const System& system, bool swap)
-  : Controller(jack, event, system, Controller::Paddles)
+  : Controller(jack, event, system, Controller::Paddles),
+    myDigitalSpeed(6),
+    myMouseXPaddle(swap ? 1 : 0),
+    myMouseYPaddle(-1)
 {
 
 #ifdef WII
@@ -57,8 +60,6 @@ Paddles::Paddles(Jack jack, const Event& event, const System& system, bool swap)
       myP1IncEvent2  = Event::JoystickZeroDown;
       myP1FireEvent1 = Event::PaddleOneFire;
       myP1FireEvent2 = Event::JoystickZeroFire3;
-
-      if(_MOUSEX_PADDLE < 0)  _MOUSEX_PADDLE = 0;
     }
     else
     {
@@ -77,8 +78,6 @@ Paddles::Paddles(Jack jack, const Event& event, const System& system, bool swap)
       myP1IncEvent2  = Event::JoystickZeroLeft;
       myP1FireEvent1 = Event::PaddleZeroFire;
       myP1FireEvent2 = Event::JoystickZeroFire1;
-
-      if(_MOUSEX_PADDLE < 0)  _MOUSEX_PADDLE = 1;
     }
   }
   else
@@ -100,8 +99,6 @@ Paddles::Paddles(Jack jack, const Event& event, const System& system, bool swap)
       myP1IncEvent2  = Event::JoystickOneDown;
       myP1FireEvent1 = Event::PaddleThreeFire;
       myP1FireEvent2 = Event::JoystickOneFire3;
-
-      if(_MOUSEX_PADDLE < 0)  _MOUSEX_PADDLE = 0;
     }
     else
     {
@@ -120,8 +117,6 @@ Paddles::Paddles(Jack jack, const Event& event, const System& system, bool swap)
       myP1IncEvent2  = Event::JoystickOneLeft;
       myP1FireEvent1 = Event::PaddleTwoFire;
       myP1FireEvent2 = Event::JoystickOneFire1;
-
-      if(_MOUSEX_PADDLE < 0)  _MOUSEX_PADDLE = 1;
     }
   }
 
@@ -354,12 +349,12 @@ void Paddles::update()
   if(myKeyRepeat0)
   {
     myPaddleRepeat0++;
-    if(myPaddleRepeat0 > _PADDLE_SPEED)  myPaddleRepeat0 = 2;
+    if(myPaddleRepeat0 > myDigitalSpeed)  myPaddleRepeat0 = 2;
   }
   if(myKeyRepeat1)
   {
     myPaddleRepeat1++;
-    if(myPaddleRepeat1 > _PADDLE_SPEED)  myPaddleRepeat1 = 2;
+    if(myPaddleRepeat1 > myDigitalSpeed)  myPaddleRepeat1 = 2;
   }
 
   myKeyRepeat0 = 0;
@@ -391,23 +386,23 @@ void Paddles::update()
   }
 
   // Mouse events
-  if(myJack == Left && (_MOUSEX_PADDLE == 0 || _MOUSEX_PADDLE == 1))
+  if(myJack == Left && (myMouseXPaddle == 0 || myMouseXPaddle == 1))
   {
     // TODO - add infrastructure to map mouse direction to increase or decrease charge
-    myCharge[_MOUSEX_PADDLE] -= myEvent.get(Event::MouseAxisXValue);
-    if(myCharge[_MOUSEX_PADDLE] < TRIGMIN) myCharge[_MOUSEX_PADDLE] = TRIGMIN;
-    if(myCharge[_MOUSEX_PADDLE] > TRIGMAX) myCharge[_MOUSEX_PADDLE] = TRIGMAX;
+    myCharge[myMouseXPaddle] -= myEvent.get(Event::MouseAxisXValue);
+    if(myCharge[myMouseXPaddle] < TRIGMIN) myCharge[myMouseXPaddle] = TRIGMIN;
+    if(myCharge[myMouseXPaddle] > TRIGMAX) myCharge[myMouseXPaddle] = TRIGMAX;
     if(myEvent.get(Event::MouseButtonValue))
-      myDigitalPinState[ourButtonPin[_MOUSEX_PADDLE]] = false;
+      myDigitalPinState[ourButtonPin[myMouseXPaddle]] = false;
   }
-  else if(myJack == Right && (_MOUSEX_PADDLE == 2 || _MOUSEX_PADDLE == 3))
+  else if(myJack == Right && (myMouseXPaddle == 2 || myMouseXPaddle == 3))
   {
     // TODO - add infrastructure to map mouse direction to increase or decrease charge
-    myCharge[_MOUSEX_PADDLE-2] -= myEvent.get(Event::MouseAxisXValue);
-    if(myCharge[_MOUSEX_PADDLE-2] < TRIGMIN) myCharge[_MOUSEX_PADDLE-2] = TRIGMIN;
-    if(myCharge[_MOUSEX_PADDLE-2] > TRIGMAX) myCharge[_MOUSEX_PADDLE-2] = TRIGMAX;
+    myCharge[myMouseXPaddle-2] -= myEvent.get(Event::MouseAxisXValue);
+    if(myCharge[myMouseXPaddle-2] < TRIGMIN) myCharge[myMouseXPaddle-2] = TRIGMIN;
+    if(myCharge[myMouseXPaddle-2] > TRIGMAX) myCharge[myMouseXPaddle-2] = TRIGMAX;
     if(myEvent.get(Event::MouseButtonValue))
-      myDigitalPinState[ourButtonPin[_MOUSEX_PADDLE-2]] = false;
+      myDigitalPinState[ourButtonPin[myMouseXPaddle-2]] = false;
   }
 
   // Axis events (possibly use analog values)
@@ -516,15 +511,10 @@ void Paddles::setMouseIsPaddle(int number, int dir)
 {
   // TODO - make mouse Y axis be actually used in the code above
   if(dir == 0)
-    _MOUSEX_PADDLE = number;
+    myMouseXPaddle = number;
   else
-    _MOUSEY_PADDLE = number;
+    myMouseYPaddle = number;
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int Paddles::_PADDLE_SPEED = 6;
-int Paddles::_MOUSEX_PADDLE = -1;
-int Paddles::_MOUSEY_PADDLE = -1;
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const Controller::DigitalPin Paddles::ourButtonPin[2] = { Four, Three };
@@ -60,13 +60,13 @@ class Paddles : public Controller
       generating paddle movement events); axis events from joysticks,
       Stelladaptors or the mouse are not modified.
     */
-    static void setDigitalSpeed(int speed) { _PADDLE_SPEED = speed; }
+    void setDigitalSpeed(int speed) { myDigitalSpeed = speed; }
 
     /**
       Sets the mouse to emulate the paddle 'number' in the X or Y
       axis.  X -> dir 0, Y -> dir 1
     */
-    static void setMouseIsPaddle(int number, int dir = 0);
+    void setMouseIsPaddle(int number, int dir = 0);
 
 #ifdef WII
     void setRightPaddleOffset( const int offset );
@@ -142,9 +142,12 @@ class Paddles : public Controller
     int wiiRightPaddleOffset;
 #endif
 
-    static int _PADDLE_SPEED;
-    static int _MOUSEX_PADDLE;
-    static int _MOUSEY_PADDLE;
+    // The speed of digital paddle movement
+    int myDigitalSpeed;
+
+    // The paddle (0 - 3) the mouse X and Y axes emulate, or -1 for none
+    int myMouseXPaddle;
+    int myMouseYPaddle;
 
     // Lookup table for associating paddle buttons with controller pins
     // Yes, this is hideously complex
@@ -17,16 +17,12 @@
 //============================================================================
 
 #include <time.h>
-#include "OSystem.hxx"
 #include "Random.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Random::Random()
 {
-  if(ourSystem)
-    myValue = ourSystem->getTicks();
-  else
-    myValue = (uInt32)time(0);
+  myValue = (uInt32)time(0);
 }
  
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -34,6 +30,3 @@ uInt32 Random::next()
 {
   return (myValue = (myValue * 2416 + 374441) % 1771875);
 }
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const OSystem* Random::ourSystem = NULL;
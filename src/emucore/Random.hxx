@@ -19,8 +19,6 @@
 #ifndef RANDOM_HXX
 #define RANDOM_HXX
 
-class OSystem;
-
 #include "bspf.hxx"
 
 /**
@@ -28,6 +26,10 @@ class OSystem;
   information in Chapter 7 of "Numerical Recipes in C".  It's a simple 
   linear congruential generator.
 
+  Each System owns one generator (see System::randGenerator()), so that
+  consoles running side by side don't share any state, and a console
+  seeded with a known value always starts up the same way.
+
   @author  Bradford W. Mott
   @version $Id: Random.hxx,v 1.7 2009-01-01 18:13:36 stephena Exp $
 */
@@ -35,34 +37,28 @@ class Random
 {
   public:
     /**
-      Create a new random number generator
+      Create a new random number generator, seeded from the current time
     */
     Random();
     
-  public:
     /**
-      Answer the next random number from the random number generator
+      Restart the sequence of random numbers from the given seed
 
-      @return A random number
+      @param seed  The value to seed the generator with
     */
-    uInt32 next();
+    void initSeed(uInt32 seed) { myValue = seed; }
 
+  public:
     /**
-      Class method which sets the OSystem in use; the constructor will
-      use this to reseed the random number generator every time a new
-      instance is created
+      Answer the next random number from the random number generator
 
-      @param system  The system currently in use
+      @return A random number
     */
-    static void setSystem(const OSystem* system) { ourSystem = system; }
+    uInt32 next();
 
   private:
     // Indicates the next random number
     uInt32 myValue;
-
-  private:
-    // Set the OSystem we're using
-    static const OSystem* ourSystem;
 };
 
 #endif
@@ -16,10 +16,16 @@
 // $Id: Serializer.cxx,v 1.14 2009-01-01 18:13:37 stephena Exp $
 //============================================================================
 
+#include <cstring>
+
 #include "Serializer.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Serializer::Serializer(void)
+  : myBuffer(0),
+    myBufferSize(0),
+    myBufferCapacity(0),
+    myUseBuffer(false)
 {
 }
 
@@ -27,6 +33,7 @@ Serializer::Serializer(void)
 Serializer::~Serializer(void)
 {
   close();
+  delete[] myBuffer;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -38,27 +45,34 @@ bool Serializer::open(const string& fileName)
   return isOpen();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Serializer::openBuffer(void)
+{
+  close();
+  myBufferSize = 0;
+  myUseBuffer = true;
+
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::close(void)
 {
   myStream.close();
   myStream.clear();
+  myUseBuffer = false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Serializer::isOpen(void)
 {
-  return myStream.is_open();
+  return myUseBuffer || myStream.is_open();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putByte(char value)
 {
-  char buf[1];
-  buf[0] = value;
-  myStream.write(buf, 1);
-  if(myStream.bad())
-    throw "Serializer: file write failed";
+  write(&value, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -68,9 +82,7 @@ void Serializer::putInt(int value)
   for(int i = 0; i < 4; ++i)
     buf[i] = (value >> (i<<3)) & 0xff;
 
-  myStream.write((char*)buf, 4);
-  if(myStream.bad())
-    throw "Serializer: file write failed";
+  write(buf, 4);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -78,10 +90,7 @@ void Serializer::putString(const string& str)
 {
   int len = str.length();
   putInt(len);
-  myStream.write(str.data(), (streamsize)len);
-
-  if(myStream.bad())
-    throw "Serializer: file write failed";
+  write(str.data(), len);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -89,3 +98,34 @@ void Serializer::putBool(bool b)
 {
   putByte(b ? TruePattern: FalsePattern);
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Serializer::write(const void* data, uInt32 length)
+{
+  if(myUseBuffer)
+  {
+    // Grow the buffer geometrically, so that building up a complete
+    // state takes only a few allocations the first time, and none after
+    if(myBufferSize + length > myBufferCapacity)
+    {
+      uInt32 capacity = BSPF_max(myBufferCapacity * 2, 4096u);
+      while(capacity < myBufferSize + length)
+        capacity *= 2;
+
+      uInt8* buffer = new uInt8[capacity];
+      if(myBuffer)
+        memcpy(buffer, myBuffer, myBufferSize);
+      delete[] myBuffer;
+      myBuffer = buffer;
+      myBufferCapacity = capacity;
+    }
+    memcpy(myBuffer + myBufferSize, data, length);
+    myBufferSize += length;
+  }
+  else
+  {
+    myStream.write((const char*)data, (streamsize)length);
+    if(myStream.bad())
+      throw "Serializer: file write failed";
+  }
+}
@@ -24,8 +24,8 @@
 
 /**
   This class implements a Serializer device, whereby data is
-  serialized and sent to an output binary file in a system-
-  independent way.
+  serialized and sent to an output binary file (or a memory buffer)
+  in a system-independent way.
 
   Bytes are written as characters, integers are written as 4 characters
   (32-bit), strings are written as characters prepended by the length of the
@@ -40,8 +40,8 @@ class Serializer
     /**
       Creates a new Serializer device.
 
-      Open must be called with a valid file before this Serializer can
-      be used.
+      Open must be called with a valid file (or openBuffer must be called)
+      before this Serializer can be used.
     */
     Serializer(void);
 
@@ -60,6 +60,26 @@ class Serializer
     */
     bool open(const string& fileName);
 
+    /**
+      Opens a growable memory buffer for output, discarding anything
+      previously written to it.  The buffer itself is kept between calls,
+      so serializing into the same object repeatedly doesn't allocate.
+
+      @return Result of opening the buffer (always true)
+    */
+    bool openBuffer(void);
+
+    /**
+      Answers the data written to the memory buffer.  This remains valid
+      after close(), up until the next call to openBuffer().
+    */
+    const uInt8* buffer(void) const { return myBuffer; }
+
+    /**
+      Answers the number of bytes written to the memory buffer.
+    */
+    uInt32 bufferSize(void) const { return myBufferSize; }
+
     /**
       Closes the current output stream.
     */
@@ -98,10 +118,21 @@ class Serializer
     */
     void putBool(bool b);
 
+  private:
+    // Send the given bytes to the output stream or buffer
+    void write(const void* data, uInt32 length);
+
   private:
     // The stream to send the serialized data to.
     fstream myStream;
 
+    // The memory buffer to send the serialized data to, used instead of
+    // the stream when opened with openBuffer()
+    uInt8* myBuffer;
+    uInt32 myBufferSize;
+    uInt32 myBufferCapacity;
+    bool myUseBuffer;
+
     enum {
       TruePattern  = 0xfe,
       FalsePattern = 0x01
@@ -60,19 +60,22 @@ Settings::Settings(OSystem* osystem)
   setInternal("palette", "standard");
   setInternal("colorloss", "false");
   setInternal("timing", "sleep");
+  setInternal("turbospeed", "4");
+  setInternal("turboframes", "4");
+  setInternal("runahead", "0");
+  setInternal("pipeline", "false");
 
   // Sound options
   setInternal("sound", "true");
   setInternal("fragsize", "512");
 #ifdef WII
   setInternal("freq", "32000");
-  setInternal("tiafreq", "32000");
 #else
   setInternal("freq", "31400");
-  setInternal("tiafreq", "31400");
 #endif  
   setInternal("volume", "100");
   setInternal("clipvol", "true");
+  setInternal("audiolog", "0");
 
   // Input event options
   setInternal("keymap", "");
@@ -116,8 +119,13 @@ Settings::Settings(OSystem* osystem)
 
   // Misc options
   setInternal("autoslot", "false");
+  setInternal("rewindfreq", "4");
+  setInternal("rewindsize", "1024");
+  setInternal("randseed", "0");
   setInternal("showinfo", "false");
   setInternal("tiafloat", "true");
+  setInternal("decode", "page");
+  setInternal("tiarender", "standard");
   setInternal("avoxport", "");
   setInternal("stats", "false");
   setInternal("audiofirst", "true");
@@ -237,6 +245,30 @@ void Settings::validate()
   if(s != "sleep" && s != "busy")
     setInternal("timing", "sleep");
 
+  i = getInt("turbospeed");
+  if(i < 0 || i > 100)
+    setInternal("turbospeed", "4");
+
+  i = getInt("turboframes");
+  if(i < 1 || i > 100)
+    setInternal("turboframes", "4");
+
+  i = getInt("runahead");
+  if(i < 0 || i > 8)
+    setInternal("runahead", "0");
+
+  i = getInt("audiolog");
+  if(i < 0 || i > 3600)
+    setInternal("audiolog", "0");
+
+  i = getInt("rewindfreq");
+  if(i < 1 || i > 300)
+    setInternal("rewindfreq", "4");
+
+  i = getInt("rewindsize");
+  if(i < 64 || i > 65536)
+    setInternal("rewindsize", "1024");
+
 #ifdef DISPLAY_OPENGL
   s = getString("gl_filter");
   if(s != "linear" && s != "nearest")
@@ -258,9 +290,6 @@ void Settings::validate()
   i = getInt("freq");
   if(i < 0 || i > 48000)
     setInternal("freq", "31400");
-  i = getInt("tiafreq");
-  if(i < 0 || i > 48000)
-    setInternal("tiafreq", "31400");
 #endif
 
   i = getInt("joydeadzone");
@@ -331,14 +360,18 @@ void Settings::usage()
     << "  -colorloss    <1|0>          Enable PAL color-loss effect\n"
     << "  -framerate    <number>       Display the given number of frames per second (0 to auto-calculate)\n"
     << "  -timing       <sleep|busy>   Use the given type of wait between frames\n"
+    << "  -turbospeed   <number>       Speed multiplier in fast-forward mode (0 for as fast as possible)\n"
+    << "  -turboframes  <number>       Draw only one of this many frames in fast-forward mode\n"
+    << "  -runahead     <number>       Show the frame this many frames ahead of the game, to hide input lag (0-8)\n"
+    << "  -pipeline     <1|0>          Emulate the next frame while drawing this one, at the cost of a frame of lag\n"
     << endl
   #ifdef SOUND_SUPPORT
     << "  -sound        <1|0>          Enable sound generation\n"
     << "  -fragsize     <number>       The size of sound fragments (must be a power of two)\n"
     << "  -freq         <number>       Set sound sample output frequency (0 - 48000)\n"
-    << "  -tiafreq      <number>       Set sound sample generation frequency (0 - 48000)\n"
     << "  -volume       <number>       Set the volume (0 - 100)\n"
     << "  -clipvol      <1|0>          Enable volume clipping (eliminates popping)\n"
+    << "  -audiolog     <number>       Log sound statistics every this many seconds (0 for never)\n"
     << endl
   #endif
     << "  -cheat        <code>         Use the specified cheatcode (see manual for description)\n"
@@ -348,6 +381,9 @@ void Settings::usage()
     << "  -sa1          <left|right>   Stelladaptor 1 emulates specified joystick port\n"
     << "  -sa2          <left|right>   Stelladaptor 2 emulates specified joystick port\n"
     << "  -autoslot     <1|0>          Automatically switch to next save slot when state saving\n"
+    << "  -rewindfreq   <number>       Capture a rewind state every this many frames (1-300)\n"
+    << "  -rewindsize   <number>       Memory used for rewind states, in KB (64-65536)\n"
+    << "  -randseed     <number>       Seed for the random contents of RAM at power-on (0 for a new one each time)\n"
     << "  -audiofirst   <1|0>          Initial audio before video (required for some ATI video cards)\n"
     << "  -ssdir        <path>         The directory to save snapshot files to\n"
     << "  -sssingle     <1|0>          Generate single snapshot instead of many\n"
@@ -385,6 +421,10 @@ void Settings::usage()
     << "   -holdbutton0                Start the emulator with the left joystick button held down\n"
     << "   -stats        <1|0>         Overlay console info during emulation\n"
     << "   -tiafloat     <1|0>         Set unused TIA pins floating on a read/peek\n"
+    << "   -decode       <page|        Decode memory in 64 byte pages or per address\n"
+    << "                  address>\n"
+    << "   -tiarender    <standard|    Draw TIA objects from per-pixel mask tables\n"
+    << "                  bitplane>      or from packed bitplanes\n"
     << endl
     << "   -bs          <arg>          Sets the 'Cartridge.Type' (bankswitch) property\n"
     << "   -type        <arg>          Same as using -bs\n"
@@ -22,6 +22,7 @@
 class OSystem;
 class Serializer;
 class Deserializer;
+class SoundStats;
 
 #include "bspf.hxx"
 
@@ -77,6 +78,17 @@ class Sound
     */
     virtual void setFrameRate(float framerate) = 0;
 
+    /**
+      Sets how many times faster than real time the emulation is running
+      (1 being real time), so that queued sound doesn't fall behind.  The
+      time between register writes is compressed by that factor, and with
+      a speed of 0 (as fast as possible) writes take effect immediately
+      without any sound being queued for them.
+
+      @param speed The speed multiplier
+    */
+    virtual void setSpeed(uInt32 speed) = 0;
+
     /**
       Start the sound system, initializing it if necessary.  This must be
       called before any calls are made to derived methods.
@@ -134,6 +146,14 @@ class Sound
     */
     virtual void adjustVolume(Int8 direction) = 0;
 
+    /**
+      Answers statistics about how well the sound is keeping up with the
+      sound card, for those sound objects which gather them.
+
+      @return The statistics, or NULL if there aren't any
+    */
+    virtual const SoundStats* stats() const { return NULL; }
+
   public:
     /**
       Loads the current state of this device from the given Deserializer.
@@ -143,6 +163,16 @@ class Sound
     */
     virtual bool load(Deserializer& in) = 0;
 
+    /**
+      Reads past the state of this device in the given Deserializer,
+      without changing the device.  This is used to load the rest of a
+      state while sound is disabled.
+
+      @param in The deserializer device to read from.
+      @return The result of the skip.  True on success, false on failure.
+    */
+    virtual bool skip(Deserializer& in) = 0;
+
     /**
       Saves the current state of this device to the given Serializer.
 
@@ -0,0 +1,158 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <cstdio>
+#include <sstream>
+
+#include "SoundStats.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SoundStats::SoundStats()
+{
+  reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SoundStats::~SoundStats()
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundStats::reset()
+{
+  myFragments = myUnderruns = mySkipped = myOverflows = 0;
+  myJitter = myMaxJitter = 0;
+  myLatency = 0;
+  myFillLevel = myFillTarget = myRateCorrection = myRateLimitCount = 0;
+  for(uInt32 i = 0; i < kBuckets; ++i)
+    myHistogram[i] = 0;
+
+  restart();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundStats::restart()
+{
+  myLastTicks = 0;
+  myLastTicksValid = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundStats::fragment(uInt32 ticks, uInt32 period, uInt32 queued,
+                          uInt32 latency)
+{
+  myFragments = myFragments + 1;
+  myLatency = latency;
+
+  // Fragments should be asked for one period apart; the running average
+  // of how far off that they are follows the last 16 or so
+  if(myLastTicksValid)
+  {
+    uInt32 interval = ticks - myLastTicks;
+    uInt32 deviation = interval > period ? interval - period : period - interval;
+    myJitter = (uInt32)((Int32)myJitter + ((Int32)deviation - (Int32)myJitter) / 16);
+    if(deviation > myMaxJitter)
+      myMaxJitter = deviation;
+  }
+  myLastTicks = ticks;
+  myLastTicksValid = true;
+
+  uInt32 bucket = 0;
+  for(uInt32 ms = queued / 2000; ms > 0 && bucket < kBuckets - 1; ms >>= 1)
+    ++bucket;
+  myHistogram[bucket] = myHistogram[bucket] + 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundStats::underrun()
+{
+  myUnderruns = myUnderruns + 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundStats::skipped(uInt32 writes)
+{
+  mySkipped = mySkipped + writes;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundStats::overflow()
+{
+  myOverflows = myOverflows + 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundStats::rateControl(uInt32 fill, uInt32 target, Int32 correction,
+                             bool limited)
+{
+  myFillLevel = fill;
+  myFillTarget = target;
+  myRateCorrection = (uInt32)correction;
+  if(limited)
+    myRateLimitCount = myRateLimitCount + 1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string SoundStats::summary() const
+{
+  char buf[64];
+  sprintf(buf, "SND %uMS U%u D%u J%.1f", (latency() + 500) / 1000,
+          underruns(), skipped() + overflows(), jitter() / 1000.0);
+
+  return buf;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string SoundStats::report() const
+{
+  ostringstream buf;
+  char line[128];
+
+  buf << "Sound statistics:" << endl
+      << "  Fragments  : " << fragments() << endl;
+  sprintf(line, "%.1f ms", latency() / 1000.0);
+  buf << "  Latency    : " << line << endl
+      << "  Underruns  : " << underruns() << endl
+      << "  Dropped    : " << skipped() << " skipped, "
+      << overflows() << " overflowed" << endl;
+  sprintf(line, "%.2f ms average, %.2f ms worst",
+          jitter() / 1000.0, maxJitter() / 1000.0);
+  buf << "  Jitter     : " << line << endl;
+  if(fillTarget() > 0)
+  {
+    sprintf(line, "%.1f ms (target %.1f ms)",
+            fillLevel() / 1000.0, fillTarget() / 1000.0);
+    buf << "  Queue fill : " << line << endl;
+    sprintf(line, "%+.3f%% (at limit for %u fragments)",
+            rateCorrection() / 10000.0, rateLimitCount());
+    buf << "  Rate       : " << line << endl;
+  }
+
+  buf << "  Queue depth:";
+  for(uInt32 i = 0; i < kBuckets; ++i)
+  {
+    if(i < kBuckets - 1)
+      sprintf(line, " <%ums %u", 2u << i, histogram(i));
+    else
+      sprintf(line, " >=%ums %u", 1u << i, histogram(i));
+    buf << line;
+  }
+  buf << endl;
+
+  return buf.str();
+}
@@ -0,0 +1,162 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef SOUND_STATS_HXX
+#define SOUND_STATS_HXX
+
+#include "bspf.hxx"
+
+/**
+  Statistics about how well the sound is keeping up with the sound card,
+  gathered while it plays, for tracking down crackling and choosing the
+  fragment size for a machine.
+
+  The numbers are recorded by whatever fills the sound fragments (the
+  sound callback thread, for SDL), except for overflows, which are
+  recorded by the emulation.  They can be read from any thread at any
+  time, though they may be a fragment out of date.  All times are in
+  microseconds.
+*/
+class SoundStats
+{
+  public:
+    /**
+      Create a new set of statistics, all zero.
+    */
+    SoundStats();
+
+    /**
+      Destructor
+    */
+    virtual ~SoundStats();
+
+  public:
+    /**
+      Zero all the statistics.  Nothing may be recorded at the same time.
+    */
+    void reset();
+
+    /**
+      Forget when the last fragment was filled, so that a pause in the
+      sound (while muted, for example) isn't counted as jitter.  Nothing
+      may be recorded at the same time.
+    */
+    void restart();
+
+    /**
+      Record the filling of a fragment.
+
+      @param ticks    The time now
+      @param period   The time a fragment takes to play
+      @param queued   The amount of sound queued for playing
+      @param latency  The estimated time from a sound register being
+                      written to it being heard
+    */
+    void fragment(uInt32 ticks, uInt32 period, uInt32 queued, uInt32 latency);
+
+    /**
+      Record a fragment which ran out of queued sound before it was filled.
+    */
+    void underrun();
+
+    /**
+      Record register writes which were applied at once rather than at
+      their proper time, because too much sound was queued.
+    */
+    void skipped(uInt32 writes);
+
+    /**
+      Record a register write which was lost because the queue was full
+      (emulation thread only).
+    */
+    void overflow();
+
+    /**
+      Record the state of rate control for a fragment.
+
+      @param fill        The amount of sound queued, averaged
+      @param target      The amount rate control is aiming for
+      @param correction  The change in playing rate, in millionths
+      @param limited     Whether the correction was at its limit
+    */
+    void rateControl(uInt32 fill, uInt32 target, Int32 correction,
+                     bool limited);
+
+  public:
+    // Number of buckets in the queue depth histogram; bucket 0 counts
+    // fragments with less than 2ms queued, bucket 1 less than 4ms, and so
+    // on, doubling each time, with the last bucket counting everything else
+    enum { kBuckets = 8 };
+
+    uInt32 fragments() const  { return myFragments;  }
+    uInt32 underruns() const  { return myUnderruns;  }
+    uInt32 skipped() const    { return mySkipped;    }
+    uInt32 overflows() const  { return myOverflows;  }
+    uInt32 jitter() const     { return myJitter;     }
+    uInt32 maxJitter() const  { return myMaxJitter;  }
+    uInt32 latency() const    { return myLatency;    }
+    uInt32 fillLevel() const  { return myFillLevel;  }
+    uInt32 fillTarget() const { return myFillTarget; }
+    Int32 rateCorrection() const { return (Int32)myRateCorrection; }
+    uInt32 rateLimitCount() const { return myRateLimitCount; }
+    uInt32 histogram(uInt32 bucket) const { return myHistogram[bucket]; }
+
+    /**
+      Answers the most important numbers (latency, underruns, dropped
+      writes and jitter) in a line short enough for the frame statistics.
+    */
+    string summary() const;
+
+    /**
+      Answers all the statistics, over several lines, for logging.
+    */
+    string report() const;
+
+  private:
+    volatile uInt32 myFragments;
+    volatile uInt32 myUnderruns;
+    volatile uInt32 mySkipped;
+    volatile uInt32 myOverflows;
+
+    // Deviation of the time between fragments from the time one takes to
+    // play: a running average, and the largest
+    volatile uInt32 myJitter;
+    volatile uInt32 myMaxJitter;
+
+    volatile uInt32 myLatency;
+
+    volatile uInt32 myFillLevel;
+    volatile uInt32 myFillTarget;
+    volatile uInt32 myRateCorrection;
+    volatile uInt32 myRateLimitCount;
+
+    volatile uInt32 myHistogram[kBuckets];
+
+    // When the last fragment was filled, if it's known
+    uInt32 myLastTicks;
+    bool myLastTicksValid;
+
+  private:
+    // Copy constructor isn't supported by this class so make it private
+    SoundStats(const SoundStats&);
+
+    // Assignment operator isn't supported by this class so make it private
+    SoundStats& operator = (const SoundStats&);
+};
+
+#endif
@@ -16,7 +16,10 @@
 // $Id: StateManager.cxx,v 1.6 2009-01-01 18:13:37 stephena Exp $
 //============================================================================
 
+#include <cstring>
+#include <fstream>
 #include <sstream>
+#include <zlib.h>
 
 #include "OSystem.hxx"
 #include "Serializer.hxx"
@@ -26,18 +29,35 @@
 #include "Control.hxx"
 #include "Switches.hxx"
 #include "System.hxx"
+#include "TIA.hxx"
 
 #include "StateManager.hxx"
 
-#define STATE_HEADER "02060000state"
-#define MOVIE_HEADER "02060000movie"
+#define STATE_HEADER "02070700state"
+#define MOVIE_HEADER "02070700movie"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 StateManager::StateManager(OSystem* osystem)
   : myOSystem(osystem),
     myCurrentSlot(0),
     myActiveMode(kOffMode),
-    myFrameCounter(0)
+    myFrameCounter(0),
+    myMovieOffset(0),
+    myMovieSegmentPos(0),
+    myMovieSegmentEnd(0),
+    myMovieFrames(0),
+    myMovieFrame(0),
+    myMovieRun(0),
+    myRewindArea(NULL),
+    myRewindAreaSize(0),
+    myRewindState(NULL),
+    myRewindStateSize(0),
+    myRewindStateCapacity(0),
+    myRewindDelta(NULL),
+    myRewindDeltaCapacity(0),
+    myRewindPacked(NULL),
+    myRewindPackedCapacity(0),
+    myRewindFrequency(1)
 {
   reset();
 }
@@ -45,6 +65,52 @@ StateManager::StateManager(OSystem* osystem)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 StateManager::~StateManager()
 {
+  clearRewindStates();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Make sure the given buffer can hold at least 'size' bytes; its contents
+// are kept
+static void growBuffer(uInt8*& buffer, uInt32& capacity, uInt32 size)
+{
+  if(size > capacity)
+  {
+    uInt8* grown = new uInt8[size];
+    if(buffer)
+      memcpy(grown, buffer, capacity);
+    delete[] buffer;
+    buffer = grown;
+    capacity = size;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Counts in the movie input are stored 7 bits per byte, low bits first,
+// with the top bit set on all but the last byte
+static void putCount(string& out, uInt32 count)
+{
+  while(count >= 0x80)
+  {
+    out += (char)((count & 0x7f) | 0x80);
+    count >>= 7;
+  }
+  out += (char)count;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static uInt32 getCount(const string& in, uInt32& pos)
+{
+  uInt32 count = 0;
+  for(int shift = 0; shift < 32; shift += 7)
+  {
+    if(pos >= in.length())
+      break;
+    uInt8 b = (uInt8) in[pos++];
+    count |= (uInt32)(b & 0x7f) << shift;
+    if(!(b & 0x80))
+      return count;
+  }
+  throw "StateManager: movie data corruption";
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -58,36 +124,49 @@ bool StateManager::toggleRecordMode()
 {
   if(myActiveMode != kMovieRecordMode)  // Turn on movie record mode
   {
-    myActiveMode = kOffMode;
+    stopActiveMode();
 
     string moviefile = /*myOSystem->baseDir() + BSPF_PATH_SEPARATOR +*/ "test.inp";
-    if(myMovieWriter.isOpen())
-      myMovieWriter.close();
     if(!myMovieWriter.open(moviefile))
       return false;
 
-    // Prepend the ROM md5 so this state file only works with that ROM
-    myMovieWriter.putString(myOSystem->console().properties().get(Cartridge_MD5));
-
-    if(!myOSystem->console().save(myMovieWriter))
+    // Save the ROM md5 so this movie only works with that ROM, and the
+    // controller types, since the input is stored as the state of the
+    // controllers (which some controllers have more of than others)
+    string header[4];
+    header[0] = MOVIE_HEADER;
+    header[1] = myOSystem->console().properties().get(Cartridge_MD5);
+    header[2] = myOSystem->console().controller(Controller::Left).name();
+    header[3] = myOSystem->console().controller(Controller::Right).name();
+
+    captureMovieInput(myMovieInput);
+    myMovieOffset = 0;
+    try
+    {
+      for(int i = 0; i < 4; ++i)
+      {
+        myMovieWriter.putString(header[i]);
+        myMovieOffset += 4 + header[i].length();
+      }
+      myMovieWriter.putInt(kMovieKeyframeInterval);
+      myMovieWriter.putInt(myMovieInput.length());
+      myMovieOffset += 8;
+    }
+    catch(const char* msg)
+    {
+      cerr << msg << endl;
+      myMovieWriter.close();
       return false;
-
-    // Save controller types for this ROM
-    // We need to check this, since some controllers save more state than
-    // normal, and those states files wouldn't be compatible with normal
-    // controllers.
-    myMovieWriter.putString(
-      myOSystem->console().controller(Controller::Left).name());
-    myMovieWriter.putString(
-      myOSystem->console().controller(Controller::Right).name());
+    }
 
     // If we get this far, we're really in movie record mode
+    myMovieIndex.clear();
+    myMovieFrame = 0;
     myActiveMode = kMovieRecordMode;
   }
   else  // Turn off movie record mode
   {
-    myActiveMode = kOffMode;
-    myMovieWriter.close();
+    stopActiveMode();
     return false;
   }
 
@@ -95,50 +174,279 @@ bool StateManager::toggleRecordMode()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool StateManager::toggleRewindMode()
+bool StateManager::togglePlaybackMode()
 {
-  // FIXME - For now, I'm going to use this to activate movie playback
-
-  // Close the writer, since we're about to re-open in read mode
-  myMovieWriter.close();
-
   if(myActiveMode != kMoviePlaybackMode)  // Turn on movie playback mode
   {
-    myActiveMode = kOffMode;
+    stopActiveMode();
 
     string moviefile = /*myOSystem->baseDir() + BSPF_PATH_SEPARATOR +*/ "test.inp";
-    if(myMovieReader.isOpen())
-      myMovieReader.close();
-    if(!myMovieReader.open(moviefile))
+    ifstream file(moviefile.c_str(), ios::binary);
+    if(!file.is_open())
       return false;
+    myMovieData.assign(istreambuf_iterator<char>(file),
+                       istreambuf_iterator<char>());
+    file.close();
 
-    // Check the ROM md5
-    if(myMovieReader.getString() !=
-       myOSystem->console().properties().get(Cartridge_MD5))
+    try
+    {
+      const uInt8* data = (const uInt8*) myMovieData.data();
+      uInt32 size = myMovieData.length();
+      if(size < 4)
+        throw "StateManager: movie file is truncated";
+
+      // Check the ROM md5, the controller types and the input size
+      Deserializer in;
+      in.openBuffer(data, size);
+      string input;
+      captureMovieInput(input);
+      if(in.getString() != MOVIE_HEADER ||
+         in.getString() !=
+           myOSystem->console().properties().get(Cartridge_MD5) ||
+         in.getString() !=
+           myOSystem->console().controller(Controller::Left).name() ||
+         in.getString() !=
+           myOSystem->console().controller(Controller::Right).name() ||
+         in.getInt() != kMovieKeyframeInterval ||
+         in.getInt() != (int) input.length())
+        throw "StateManager: movie doesn't match this ROM";
+
+      // The last thing in the file is where the index starts
+      in.openBuffer(data + size - 4, 4);
+      uInt32 index = (uInt32) in.getInt();
+      if(index > size - 4)
+        throw "StateManager: movie data corruption";
+
+      in.openBuffer(data + index, size - 4 - index);
+      uInt32 segments = (uInt32) in.getInt();
+      myMovieIndex.clear();
+      for(uInt32 i = 0; i < segments; ++i)
+      {
+        uInt32 offset = (uInt32) in.getInt();
+        if(offset >= index)
+          throw "StateManager: movie data corruption";
+        myMovieIndex.push_back(offset);
+      }
+      myMovieFrames = (uInt32) in.getInt();
+      if(myMovieFrames > segments * kMovieKeyframeInterval)
+        throw "StateManager: movie data corruption";
+    }
+    catch(const char* msg)
+    {
+      cerr << msg << endl;
+      myMovieData = "";
+      myMovieIndex.clear();
       return false;
+    }
 
-    if(!myOSystem->console().load(myMovieReader))
+    // If we get this far, we're really in movie playback mode
+    myActiveMode = kMoviePlaybackMode;
+    if(!seekMovie(0))
+    {
+      stopActiveMode();
       return false;
+    }
+  }
+  else  // Turn off movie playback mode
+  {
+    stopActiveMode();
+    return false;
+  }
+
+  return myActiveMode == kMoviePlaybackMode;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StateManager::seekMovie(uInt32 frame)
+{
+  if(myActiveMode != kMoviePlaybackMode || frame >= myMovieFrames)
+    return false;
+
+  try
+  {
+    openMovieSegment(frame / kMovieKeyframeInterval, true);
+  }
+  catch(const char* msg)
+  {
+    cerr << msg << endl;
+    return false;
+  }
+
+  // Replay the frames from the keyframe up to the requested one, without
+  // drawing or playing them
+  TIA& tia = myOSystem->console().tia();
+  tia.enableRendering(false);
+  tia.enableSound(false);
+  for(; myMovieFrame < frame; ++myMovieFrame)
+  {
+    nextMovieInput();
+    applyMovieInput(myMovieInput);
+    tia.update();
+  }
+  tia.enableSound(true);
+  tia.enableRendering(true);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StateManager::toggleRewindMode()
+{
+  if(myActiveMode != kRewindRecordMode)  // Turn on rewind mode
+  {
+    stopActiveMode();
 
-    // Check controller types
-    const string& left  = myMovieReader.getString();
-    const string& right = myMovieReader.getString();
+    myRewindFrequency = myOSystem->settings().getInt("rewindfreq");
+    myRewindAreaSize  = myOSystem->settings().getInt("rewindsize") * 1024;
+    myRewindArea = new uInt8[myRewindAreaSize];
 
-    if(left != myOSystem->console().controller(Controller::Left).name() ||
-       right != myOSystem->console().controller(Controller::Right).name())
+    // Start off with the current state, so there's always a full state
+    // for the deltas to be applied to
+    myRewindStateSize = 0;
+    captureRewindState();
+    if(myRewindStateSize == 0)
+    {
+      clearRewindStates();
       return false;
+    }
 
-    // If we get this far, we're really in movie record mode
-    myActiveMode = kMoviePlaybackMode;
+    myFrameCounter = 0;
+    myActiveMode = kRewindRecordMode;
   }
-  else  // Turn off movie playback mode
+  else  // Turn off rewind mode
   {
-    myActiveMode = kOffMode;
-    myMovieReader.close();
+    stopActiveMode();
     return false;
   }
 
-  return myActiveMode == kMoviePlaybackMode;
+  return myActiveMode == kRewindRecordMode;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StateManager::captureRewindState()
+{
+  myRewindWriter.openBuffer();
+  if(!myOSystem->console().save(myRewindWriter))
+    return;
+
+  const uInt8* state = myRewindWriter.buffer();
+  uInt32 length = myRewindWriter.bufferSize();
+
+  // The previous state becomes a delta against this one (if there is one)
+  if(myRewindStateSize > 0)
+  {
+    uInt32 previous = myRewindStateSize;
+    growBuffer(myRewindDelta, myRewindDeltaCapacity, previous);
+    for(uInt32 i = 0; i < previous; ++i)
+      myRewindDelta[i] = myRewindState[i] ^ (i < length ? state[i] : 0);
+
+    uLongf size = compressBound(previous);
+    growBuffer(myRewindPacked, myRewindPackedCapacity, size);
+    if(compress2(myRewindPacked, &size, myRewindDelta, previous,
+                 Z_BEST_SPEED) == Z_OK && size <= myRewindAreaSize)
+    {
+      // Put the delta right after the newest one, or back at the start
+      // of the area if it doesn't fit there, and drop whatever older
+      // deltas it overlaps
+      uInt32 offset = 0;
+      if(!myRewindStates.empty())
+        offset = myRewindStates.back().offset + myRewindStates.back().size;
+      if(offset + size > myRewindAreaSize)
+      {
+        while(!myRewindStates.empty() &&
+              myRewindStates.front().offset >= offset)
+          myRewindStates.pop_front();
+        offset = 0;
+      }
+      while(!myRewindStates.empty() &&
+            myRewindStates.front().offset >= offset &&
+            myRewindStates.front().offset < offset + size)
+        myRewindStates.pop_front();
+
+      memcpy(myRewindArea + offset, myRewindPacked, size);
+      RewindState entry;
+      entry.offset = offset;
+      entry.size   = (uInt32) size;
+      entry.length = previous;
+      myRewindStates.push_back(entry);
+    }
+    else  // Too big to store, so nothing older can be restored either
+      myRewindStates.clear();
+  }
+
+  growBuffer(myRewindState, myRewindStateCapacity, length);
+  memcpy(myRewindState, state, length);
+  myRewindStateSize = length;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StateManager::rewindState()
+{
+  if(myActiveMode == kMoviePlaybackMode)
+  {
+    uInt32 second = (uInt32) myOSystem->frameRate();
+    seekMovie(myMovieFrame > second ? myMovieFrame - second : 0);
+    return;
+  }
+  else if(myActiveMode != kRewindRecordMode)
+  {
+    myOSystem->frameBuffer().showMessage("Rewind mode isn't enabled");
+    return;
+  }
+
+  // Go back to the newest state first, unless we're already there
+  if(myFrameCounter == 0)
+  {
+    if(myRewindStates.empty())
+    {
+      myOSystem->frameBuffer().showMessage("No more rewind states");
+      return;
+    }
+
+    // Undo the delta to get the state before the newest one
+    const RewindState& entry = myRewindStates.back();
+    growBuffer(myRewindDelta, myRewindDeltaCapacity, entry.length);
+    uLongf length = entry.length;
+    if(uncompress(myRewindDelta, &length, myRewindArea + entry.offset,
+                  entry.size) != Z_OK || length != entry.length)
+    {
+      myRewindStates.clear();
+      myOSystem->frameBuffer().showMessage("Rewind state is corrupt");
+      return;
+    }
+
+    growBuffer(myRewindState, myRewindStateCapacity, entry.length);
+    for(uInt32 i = 0; i < entry.length; ++i)
+      myRewindState[i] = myRewindDelta[i] ^
+                         (i < myRewindStateSize ? myRewindState[i] : 0);
+    myRewindStateSize = entry.length;
+    myRewindStates.pop_back();
+  }
+
+  Deserializer in;
+  in.openBuffer(myRewindState, myRewindStateSize);
+  if(!myOSystem->console().load(in))
+  {
+    myOSystem->frameBuffer().showMessage("Error loading rewind state");
+    return;
+  }
+  myFrameCounter = 0;
+
+  ostringstream buf;
+  buf << "Rewind (" << myRewindStates.size() << " states left)";
+  myOSystem->frameBuffer().showMessage(buf.str());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StateManager::clearRewindStates()
+{
+  myRewindStates.clear();
+  delete[] myRewindArea;    myRewindArea   = NULL;
+  delete[] myRewindState;   myRewindState  = NULL;
+  delete[] myRewindDelta;   myRewindDelta  = NULL;
+  delete[] myRewindPacked;  myRewindPacked = NULL;
+  myRewindAreaSize = myRewindStateSize = 0;
+  myRewindStateCapacity = myRewindDeltaCapacity = myRewindPackedCapacity = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -147,15 +455,83 @@ void StateManager::update()
   switch(myActiveMode)
   {
     case kMovieRecordMode:
-      myOSystem->console().controller(Controller::Left).save(myMovieWriter);
-      myOSystem->console().controller(Controller::Right).save(myMovieWriter);
-      myOSystem->console().switches().save(myMovieWriter);
+    {
+      string input;
+      captureMovieInput(input);
+      if(myMovieFrame % kMovieKeyframeInterval == 0)
+      {
+        // Start a new segment, with the state before this frame
+        try
+        {
+          if(myMovieFrame > 0)
+            writeMovieSegment();
+        }
+        catch(const char* msg)
+        {
+          cerr << msg << endl;
+          myMovieFrame = 0;  // Don't try to write this segment again
+          stopActiveMode();
+          myOSystem->frameBuffer().showMessage("Recording error");
+          break;
+        }
+        myMovieKeyframe.openBuffer();
+        myOSystem->console().save(myMovieKeyframe);
+        myMovieSegment = input;
+        myMovieRun = 1;
+      }
+      else if(input == myMovieInput)
+        ++myMovieRun;
+      else
+      {
+        // Mark the bytes which changed, and add their new values
+        uInt32 length = input.length();
+        string changes((length + 7) / 8, 0);
+        for(uInt32 i = 0; i < length; ++i)
+          if(input[i] != myMovieInput[i])
+            changes[i / 8] |= 1 << (i % 8);
+        for(uInt32 i = 0; i < length; ++i)
+          if(input[i] != myMovieInput[i])
+            changes += input[i];
+
+        putCount(myMovieSegment, myMovieRun);
+        myMovieSegment += changes;
+        myMovieRun = 1;
+      }
+      myMovieInput = input;
+      ++myMovieFrame;
       break;
+    }
 
     case kMoviePlaybackMode:
-      myOSystem->console().controller(Controller::Left).load(myMovieReader);
-      myOSystem->console().controller(Controller::Right).load(myMovieReader);
-      myOSystem->console().switches().load(myMovieReader);
+      if(myMovieFrame >= myMovieFrames)
+      {
+        stopActiveMode();
+        myOSystem->frameBuffer().showMessage("Playback finished");
+        break;
+      }
+      try
+      {
+        if(myMovieFrame == myMovieSegmentEnd)
+          openMovieSegment(myMovieFrame / kMovieKeyframeInterval, false);
+        nextMovieInput();
+      }
+      catch(const char* msg)
+      {
+        cerr << msg << endl;
+        stopActiveMode();
+        myOSystem->frameBuffer().showMessage("Playback error");
+        break;
+      }
+      applyMovieInput(myMovieInput);
+      ++myMovieFrame;
+      break;
+
+    case kRewindRecordMode:
+      if(++myFrameCounter >= myRewindFrequency)
+      {
+        captureRewindState();
+        myFrameCounter = 0;
+      }
       break;
 
     default:
@@ -266,15 +642,42 @@ void StateManager::changeState()
 void StateManager::reset()
 {
   myCurrentSlot = 0;
+  stopActiveMode();
+}
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StateManager::stopActiveMode()
+{
   switch(myActiveMode)
   {
     case kMovieRecordMode:
+      // Add the last segment, then the index and where it starts
+      try
+      {
+        if(myMovieFrame > 0)
+          writeMovieSegment();
+        myMovieWriter.putInt(myMovieIndex.size());
+        for(uInt32 i = 0; i < myMovieIndex.size(); ++i)
+          myMovieWriter.putInt(myMovieIndex[i]);
+        myMovieWriter.putInt(myMovieFrame);
+        myMovieWriter.putInt(myMovieOffset);
+      }
+      catch(const char* msg)
+      {
+        cerr << msg << endl;
+      }
       myMovieWriter.close();
+      myMovieSegment = "";
+      myMovieIndex.clear();
       break;
 
     case kMoviePlaybackMode:
-      myMovieReader.close();
+      myMovieData = myMovieSegmentData = "";
+      myMovieIndex.clear();
+      break;
+
+    case kRewindRecordMode:
+      clearRewindStates();
       break;
 
     default:
@@ -283,6 +686,125 @@ void StateManager::reset()
   myActiveMode = kOffMode;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StateManager::captureMovieInput(string& input)
+{
+  myMovieInputWriter.openBuffer();
+  myOSystem->console().controller(Controller::Left).save(myMovieInputWriter);
+  myOSystem->console().controller(Controller::Right).save(myMovieInputWriter);
+  myOSystem->console().switches().save(myMovieInputWriter);
+  input.assign((const char*) myMovieInputWriter.buffer(),
+               myMovieInputWriter.bufferSize());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StateManager::applyMovieInput(const string& input)
+{
+  Deserializer in;
+  in.openBuffer((const uInt8*) input.data(), input.length());
+  myOSystem->console().controller(Controller::Left).load(in);
+  myOSystem->console().controller(Controller::Right).load(in);
+  myOSystem->console().switches().load(in);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StateManager::writeMovieSegment()
+{
+  uInt32 frames = (myMovieFrame - 1) % kMovieKeyframeInterval + 1;
+  putCount(myMovieSegment, myMovieRun);
+
+  Serializer raw;
+  raw.openBuffer();
+  raw.putString(string((const char*) myMovieKeyframe.buffer(),
+                       myMovieKeyframe.bufferSize()));
+  raw.putString(myMovieSegment);
+
+  uLongf size = compressBound(raw.bufferSize());
+  string packed(size, 0);
+  if(compress2((Bytef*) &packed[0], &size, raw.buffer(), raw.bufferSize(),
+               Z_BEST_COMPRESSION) != Z_OK)
+    throw "StateManager: couldn't compress movie";
+  packed.resize(size);
+
+  myMovieIndex.push_back(myMovieOffset);
+  myMovieWriter.putInt(myMovieFrame - frames);
+  myMovieWriter.putInt(frames);
+  myMovieWriter.putInt(raw.bufferSize());
+  myMovieWriter.putString(packed);
+  myMovieOffset += 16 + packed.length();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StateManager::openMovieSegment(uInt32 segment, bool loadKeyframe)
+{
+  if(segment >= myMovieIndex.size())
+    throw "StateManager: movie data corruption";
+
+  Deserializer in;
+  uInt32 offset = myMovieIndex[segment];
+  in.openBuffer((const uInt8*) myMovieData.data() + offset,
+                myMovieData.length() - offset);
+  uInt32 first  = (uInt32) in.getInt();
+  uInt32 frames = (uInt32) in.getInt();
+  uLongf length = (uInt32) in.getInt();
+  const string& packed = in.getString();
+  if(first != segment * kMovieKeyframeInterval ||
+     frames > kMovieKeyframeInterval || length > 0x1000000)
+    throw "StateManager: movie data corruption";
+
+  string raw(length, 0);
+  if(uncompress((Bytef*) &raw[0], &length, (const Bytef*) packed.data(),
+                packed.length()) != Z_OK || length != raw.length())
+    throw "StateManager: movie data corruption";
+
+  in.openBuffer((const uInt8*) raw.data(), raw.length());
+  const string& keyframe = in.getString();
+  myMovieSegmentData = in.getString();
+
+  if(loadKeyframe)
+  {
+    in.openBuffer((const uInt8*) keyframe.data(), keyframe.length());
+    if(!myOSystem->console().load(in))
+      throw "StateManager: couldn't load movie keyframe";
+  }
+
+  // The first frame's input is stored in full
+  string input;
+  captureMovieInput(input);
+  if(myMovieSegmentData.length() < input.length())
+    throw "StateManager: movie data corruption";
+  myMovieInput = myMovieSegmentData.substr(0, input.length());
+  myMovieSegmentPos = input.length();
+  myMovieRun = getCount(myMovieSegmentData, myMovieSegmentPos);
+
+  myMovieFrame = first;
+  myMovieSegmentEnd = first + frames;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StateManager::nextMovieInput()
+{
+  if(myMovieRun == 0)
+  {
+    // Get the bytes which changed, then their new values
+    uInt32 length = myMovieInput.length();
+    uInt32 mask = myMovieSegmentPos;
+    myMovieSegmentPos += (length + 7) / 8;
+    if(myMovieSegmentPos > myMovieSegmentData.length())
+      throw "StateManager: movie data corruption";
+    for(uInt32 i = 0; i < length; ++i)
+    {
+      if(!(myMovieSegmentData[mask + i / 8] & (1 << (i % 8))))
+        continue;
+      if(myMovieSegmentPos >= myMovieSegmentData.length())
+        throw "StateManager: movie data corruption";
+      myMovieInput[i] = myMovieSegmentData[myMovieSegmentPos++];
+    }
+    myMovieRun = getCount(myMovieSegmentData, myMovieSegmentPos);
+  }
+  --myMovieRun;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 StateManager::StateManager(const StateManager&)
 {
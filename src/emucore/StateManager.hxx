@@ -21,6 +21,8 @@
 
 class OSystem;
 
+#include <deque>
+
 #include "Deserializer.hxx"
 #include "Serializer.hxx"
 
@@ -52,8 +54,33 @@ class StateManager
     bool isActive();
 
     bool toggleRecordMode();
+    bool togglePlaybackMode();
+
+    /**
+      Jumps to the given frame of the movie being played back, by loading
+      the nearest keyframe before it and replaying the input from there.
+
+      @param frame  The frame to continue playback from
+      @return  Whether the movie could be positioned at that frame
+    */
+    bool seekMovie(uInt32 frame);
+
+    /**
+      Turns rewind mode on or off.  While it's on, the console state is
+      captured every 'rewindfreq' frames into a buffer of at most
+      'rewindsize' KB, from which rewindState() can restore them.
+
+      @return  Whether rewind mode is now on
+    */
     bool toggleRewindMode();
 
+    /**
+      Steps back to the most recent state captured in rewind mode which
+      is older than the current one, discarding the newer ones.  During
+      movie playback, steps back one second in the movie instead.
+    */
+    void rewindState();
+
     /**
       Updates the state of the system based on the currently active mode
     */
@@ -90,6 +117,30 @@ class StateManager
     // Assignment operator isn't supported by this class so make it private
     StateManager& operator = (const StateManager&);
 
+    // Leave record, playback or rewind mode, whichever one is active
+    void stopActiveMode();
+
+    // Capture the current console state into the rewind buffer
+    void captureRewindState();
+
+    // Free everything used by rewind mode
+    void clearRewindStates();
+
+    // Get the input of the current frame (the state of both controllers
+    // and the console switches), or make it the current input
+    void captureMovieInput(string& input);
+    void applyMovieInput(const string& input);
+
+    // Compress the segment being recorded and add it to the movie file
+    void writeMovieSegment();
+
+    // Decompress the given segment of the movie being played back, and
+    // optionally load its keyframe
+    void openMovieSegment(uInt32 segment, bool loadKeyframe);
+
+    // Decode the input of the next frame of the movie being played back
+    void nextMovieInput();
+
   private:
     enum Mode {
       kOffMode,
@@ -100,7 +151,8 @@ class StateManager
     };
 
     enum {
-      kVersion = 001
+      kVersion = 001,
+      kMovieKeyframeInterval = 600
     };
 
     // The parent OSystem object
@@ -118,9 +170,67 @@ class StateManager
     // MD5 of the currently active ROM (either in movie or rewind mode)
     string myMD5;
 
-    // Serializer classes used to save/load the eventstream
-    Serializer   myMovieWriter;
-    Deserializer myMovieReader;
+    // A movie is a sequence of segments of kMovieKeyframeInterval frames.
+    // Each segment holds the console state at its first frame (its
+    // keyframe) and the input for all its frames, zlib-compressed.  The
+    // input is stored as the first frame's input in full, followed by
+    // runs: the number of frames the input stays the same, then which
+    // bytes of it change and their new values.  An index of where each
+    // segment starts comes at the end of the file, so any frame can be
+    // reached by loading a keyframe and replaying at most one segment.
+    Serializer myMovieWriter;
+
+    // The segment being recorded, and where it will go in the file
+    Serializer myMovieKeyframe;
+    string myMovieSegment;
+    uInt32 myMovieOffset;
+    deque<uInt32> myMovieIndex;
+
+    // The whole movie being played back, and the segment being decoded
+    string myMovieData;
+    string myMovieSegmentData;
+    uInt32 myMovieSegmentPos;
+    uInt32 myMovieSegmentEnd;
+    uInt32 myMovieFrames;
+
+    // The current frame, and its input (which has lasted for 'run'
+    // frames when recording, or lasts for 'run' more when playing)
+    uInt32 myMovieFrame;
+    string myMovieInput;
+    uInt32 myMovieRun;
+    Serializer myMovieInputWriter;
+
+    // In rewind mode only the most recently captured state is kept in
+    // full.  Every older state is kept as the XOR of it with the state
+    // captured after it (mostly zeros, since little changes between
+    // frames), compressed with zlib.  The compressed deltas are stored
+    // one after the other in a fixed-size circular area, so the oldest
+    // ones are overwritten as newer ones are added.
+    struct RewindState {
+      uInt32 offset;  // Where the compressed delta starts in the area
+      uInt32 size;    // Size of the compressed delta
+      uInt32 length;  // Size of the state it restores
+    };
+    deque<RewindState> myRewindStates;
+    uInt8* myRewindArea;
+    uInt32 myRewindAreaSize;
+
+    // The most recently captured state
+    uInt8* myRewindState;
+    uInt32 myRewindStateSize;
+    uInt32 myRewindStateCapacity;
+
+    // Space for a delta while it's being (de)compressed
+    uInt8* myRewindDelta;
+    uInt32 myRewindDeltaCapacity;
+    uInt8* myRewindPacked;
+    uInt32 myRewindPackedCapacity;
+
+    // Number of frames between captured states
+    int myRewindFrequency;
+
+    // Used to serialize the console state for rewind mode
+    Serializer myRewindWriter;
 };
 
 #endif
@@ -60,6 +60,14 @@ class Switches : public Serializable
     */
     uInt8 read() const { return mySwitches; }
 
+    /**
+      Set the value of the console switches (used when restoring a state
+      snapshot, see Console::restoreState())
+
+      @param value  The 8 bits which represent the state of the switches
+    */
+    void write(uInt8 value) { mySwitches = value; }
+
     /**
       Update the switches variable
     */
@@ -53,7 +53,10 @@ TIA::TIA(Console& console, Sound& sound, Settings& settings)
     myPartialFrameFlag(false),
     myFrameGreyed(false),
     myAutoFrameEnabled(false),
-    myFrameCounter(0)
+    myFrameCounter(0),
+    myRenderingEnabled(true),
+    myRenderingRequested(true),
+    mySoundEnabled(true)
 {
   // Allocate buffers for two frame buffers
   myCurrentFrameBuffer = new uInt8[160 * 300];
@@ -99,9 +102,6 @@ TIA::TIA(Console& console, Sound& sound, Settings& settings)
     }
   }
 
-  // Compute all of the mask tables
-  TIATables::computeAllTables();
-
   // Zero audio registers
   myAUDV0 = myAUDV1 = myAUDF0 = myAUDF1 = myAUDC0 = myAUDC1 = 0;
 }
@@ -168,6 +168,11 @@ void TIA::reset()
 
   myFloatTIAOutputPins = mySettings.getBool("tiafloat");
 
+  myBitplaneRendering = (mySettings.getString("tiarender") == "bitplane");
+  myP0Bitplanes.source = myP1Bitplanes.source = 0;
+  myM0Bitplanes.source = myM1Bitplanes.source = 0;
+  myBLBitplanes.source = myPFBitplanes.source = 0;
+
   myAutoFrameEnabled = (mySettings.getInt("framerate") <= 0);
   myFramerate = myConsole.getFramerate();
 
@@ -228,7 +233,8 @@ void TIA::systemCyclesReset()
   uInt32 cycles = mySystem->cycles();
 
   // Adjust the sound cycle indicator
-  mySound.adjustCycleCounter(-1 * cycles);
+  if(mySoundEnabled)
+    mySound.adjustCycleCounter(-1 * cycles);
 
   // Adjust the dump cycle
   myDumpDisabledCycle -= cycles;
@@ -294,6 +300,8 @@ bool TIA::save(Serializer& out) const
     out.putInt(myScanlineCountForLastFrame);
     out.putInt(myCurrentScanline);
     out.putInt(myVSYNCFinishClock);
+    out.putBool(myPartialFrameFlag);
+    out.putInt(myFramePointer - myCurrentFrameBuffer);
 
     out.putByte((char)myEnabledObjects);
 
@@ -340,13 +348,15 @@ bool TIA::save(Serializer& out) const
     out.putByte((char)myCurrentGRP0);
     out.putByte((char)myCurrentGRP1);
 
-// pointers
-//  myCurrentBLMask = TIATables::BallMaskTable[0][0];
-//  myCurrentM0Mask = TIATables::MissleMaskTable[0][0][0];
-//  myCurrentM1Mask = TIATables::MissleMaskTable[0][0][0];
-//  myCurrentP0Mask = TIATables::PlayerMaskTable[0][0][0];
-//  myCurrentP1Mask = TIATables::PlayerMaskTable[0][0][0];
-//  myCurrentPFMask = TIATables::PlayfieldTable[0];
+    // The current masks are saved as offsets into their tables, since
+    // they can't always be worked out from the registers (the first copy
+    // of a player may be skipped, a missle may be disabled, etc)
+    out.putInt(myCurrentBLMask - &TIATables::BallMaskTable[0][0][0]);
+    out.putInt(missleMaskOffset(myCurrentM0Mask));
+    out.putInt(missleMaskOffset(myCurrentM1Mask));
+    out.putInt(myCurrentP0Mask - &TIATables::PlayerMaskTable[0][0][0][0]);
+    out.putInt(myCurrentP1Mask - &TIATables::PlayerMaskTable[0][0][0][0]);
+    out.putBool(myCurrentPFMask == TIATables::PlayfieldTable[1]);
 
     out.putInt(myLastHMOVEClock);
     out.putBool(myHMOVEBlankEnabled);
@@ -391,6 +401,11 @@ bool TIA::load(Deserializer& in)
     myScanlineCountForLastFrame = (Int32) in.getInt();
     myCurrentScanline = (Int32) in.getInt();
     myVSYNCFinishClock = (Int32) in.getInt();
+    myPartialFrameFlag = in.getBool();
+    uInt32 pixel = (uInt32) in.getInt();
+    if(pixel > 160 * 300)
+      return false;
+    myFramePointer = myCurrentFrameBuffer + pixel;
 
     myEnabledObjects = (uInt8) in.getByte();
 
@@ -437,13 +452,21 @@ bool TIA::load(Deserializer& in)
     myCurrentGRP0 = (uInt8) in.getByte();
     myCurrentGRP1 = (uInt8) in.getByte();
 
-// pointers
-//  myCurrentBLMask = TIATables::BallMaskTable[0][0];
-//  myCurrentM0Mask = TIATables::MissleMaskTable[0][0][0];
-//  myCurrentM1Mask = TIATables::MissleMaskTable[0][0][0];
-//  myCurrentP0Mask = TIATables::PlayerMaskTable[0][0][0];
-//  myCurrentP1Mask = TIATables::PlayerMaskTable[0][0][0];
-//  myCurrentPFMask = TIATables::PlayfieldTable[0];
+    uInt32 bl = (uInt32) in.getInt();
+    Int32 m0 = (Int32) in.getInt(), m1 = (Int32) in.getInt();
+    uInt32 p0 = (uInt32) in.getInt(), p1 = (uInt32) in.getInt();
+    if(bl >= sizeof(TIATables::BallMaskTable) ||
+       m0 >= (Int32) sizeof(TIATables::MissleMaskTable) ||
+       m1 >= (Int32) sizeof(TIATables::MissleMaskTable) ||
+       p0 >= sizeof(TIATables::PlayerMaskTable) ||
+       p1 >= sizeof(TIATables::PlayerMaskTable))
+      return false;
+    myCurrentBLMask = &TIATables::BallMaskTable[0][0][0] + bl;
+    myCurrentM0Mask = missleMask(m0);
+    myCurrentM1Mask = missleMask(m1);
+    myCurrentP0Mask = &TIATables::PlayerMaskTable[0][0][0][0] + p0;
+    myCurrentP1Mask = &TIATables::PlayerMaskTable[0][0][0][0] + p1;
+    myCurrentPFMask = TIATables::PlayfieldTable[in.getBool() ? 1 : 0];
 
     myLastHMOVEClock = (Int32) in.getInt();
     myHMOVEBlankEnabled = in.getBool();
@@ -454,7 +477,12 @@ bool TIA::load(Deserializer& in)
     myDumpDisabledCycle = (Int32) in.getInt();
 
     // Load the sound sample stuff ...
-    mySound.load(in);
+    // When sound is disabled, the sound device still has the state it
+    // had when this was saved, so the saved copy is skipped over
+    if(mySoundEnabled)
+      mySound.load(in);
+    else if(!mySound.skip(in))
+      return false;
 
     // Reset TIA bits to be on
     enableBits(true);
@@ -473,6 +501,181 @@ bool TIA::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The device state copied by cloneState(); this is everything written by
+// save() except the sound device, plus the audio registers
+struct TIAState
+{
+  Int32 clockWhenFrameStarted, clockStartDisplay, clockStopDisplay;
+  Int32 clockAtLastUpdate, clocksToEndOfScanLine;
+  Int32 scanlineCountForLastFrame, currentScanline, VSYNCFinishClock;
+  uInt32 framePointer;
+  bool partialFrameFlag;
+  uInt8 enabledObjects;
+  uInt8 VSYNC, VBLANK, NUSIZ0, NUSIZ1;
+  uInt32 COLUP0, COLUP1, COLUPF, COLUBK;
+  uInt8 CTRLPF, playfieldPriorityAndScore;
+  bool REFP0, REFP1;
+  uInt32 PF;
+  uInt8 GRP0, GRP1, DGRP0, DGRP1;
+  bool ENAM0, ENAM1, ENABL, DENABL;
+  Int8 HMP0, HMP1, HMM0, HMM1, HMBL;
+  bool VDELP0, VDELP1, VDELBL, RESMP0, RESMP1;
+  uInt16 collision;
+  Int16 POSP0, POSP1, POSM0, POSM1, POSBL;
+  uInt8 currentGRP0, currentGRP1;
+  const uInt8* currentBLMask;
+  const uInt8* currentM0Mask;
+  const uInt8* currentM1Mask;
+  const uInt8* currentP0Mask;
+  const uInt8* currentP1Mask;
+  const uInt32* currentPFMask;
+  uInt8 AUDV0, AUDV1, AUDC0, AUDC1, AUDF0, AUDF1;
+  Int32 lastHMOVEClock;
+  bool HMOVEBlankEnabled;
+  bool M0CosmicArkMotionEnabled;
+  uInt32 M0CosmicArkCounter;
+  bool dumpEnabled;
+  Int32 dumpDisabledCycle;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TIA::stateSize() const
+{
+  return sizeof(TIAState);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TIA::cloneState(uInt8* state) const
+{
+  // The mask pointers are copied as-is, since a snapshot is never used
+  // outside of this process (unlike the offsets written by save())
+  TIAState s;
+  memset(&s, 0, sizeof(s));  // so that padding bytes hash the same
+  s.clockWhenFrameStarted = myClockWhenFrameStarted;
+  s.clockStartDisplay = myClockStartDisplay;
+  s.clockStopDisplay = myClockStopDisplay;
+  s.clockAtLastUpdate = myClockAtLastUpdate;
+  s.clocksToEndOfScanLine = myClocksToEndOfScanLine;
+  s.scanlineCountForLastFrame = myScanlineCountForLastFrame;
+  s.currentScanline = myCurrentScanline;
+  s.VSYNCFinishClock = myVSYNCFinishClock;
+  s.framePointer = myFramePointer - myCurrentFrameBuffer;
+  s.partialFrameFlag = myPartialFrameFlag;
+  s.enabledObjects = myEnabledObjects;
+  s.VSYNC = myVSYNC;  s.VBLANK = myVBLANK;
+  s.NUSIZ0 = myNUSIZ0;  s.NUSIZ1 = myNUSIZ1;
+  s.COLUP0 = myCOLUP0;  s.COLUP1 = myCOLUP1;
+  s.COLUPF = myCOLUPF;  s.COLUBK = myCOLUBK;
+  s.CTRLPF = myCTRLPF;
+  s.playfieldPriorityAndScore = myPlayfieldPriorityAndScore;
+  s.REFP0 = myREFP0;  s.REFP1 = myREFP1;
+  s.PF = myPF;
+  s.GRP0 = myGRP0;  s.GRP1 = myGRP1;  s.DGRP0 = myDGRP0;  s.DGRP1 = myDGRP1;
+  s.ENAM0 = myENAM0;  s.ENAM1 = myENAM1;
+  s.ENABL = myENABL;  s.DENABL = myDENABL;
+  s.HMP0 = myHMP0;  s.HMP1 = myHMP1;
+  s.HMM0 = myHMM0;  s.HMM1 = myHMM1;  s.HMBL = myHMBL;
+  s.VDELP0 = myVDELP0;  s.VDELP1 = myVDELP1;  s.VDELBL = myVDELBL;
+  s.RESMP0 = myRESMP0;  s.RESMP1 = myRESMP1;
+  s.collision = myCollision;
+  s.POSP0 = myPOSP0;  s.POSP1 = myPOSP1;
+  s.POSM0 = myPOSM0;  s.POSM1 = myPOSM1;  s.POSBL = myPOSBL;
+  s.currentGRP0 = myCurrentGRP0;  s.currentGRP1 = myCurrentGRP1;
+  s.currentBLMask = myCurrentBLMask;
+  s.currentM0Mask = myCurrentM0Mask;
+  s.currentM1Mask = myCurrentM1Mask;
+  s.currentP0Mask = myCurrentP0Mask;
+  s.currentP1Mask = myCurrentP1Mask;
+  s.currentPFMask = myCurrentPFMask;
+  s.AUDV0 = myAUDV0;  s.AUDV1 = myAUDV1;
+  s.AUDC0 = myAUDC0;  s.AUDC1 = myAUDC1;
+  s.AUDF0 = myAUDF0;  s.AUDF1 = myAUDF1;
+  s.lastHMOVEClock = myLastHMOVEClock;
+  s.HMOVEBlankEnabled = myHMOVEBlankEnabled;
+  s.M0CosmicArkMotionEnabled = myM0CosmicArkMotionEnabled;
+  s.M0CosmicArkCounter = myM0CosmicArkCounter;
+  s.dumpEnabled = myDumpEnabled;
+  s.dumpDisabledCycle = myDumpDisabledCycle;
+  memcpy(state, &s, sizeof(s));
+
+  return sizeof(s);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TIA::restoreState(const uInt8* state)
+{
+  // Unlike load(), this leaves the sound device and the TIA bits (which
+  // are a debugging aid rather than emulation state) alone
+  TIAState s;
+  memcpy(&s, state, sizeof(s));
+  myClockWhenFrameStarted = s.clockWhenFrameStarted;
+  myClockStartDisplay = s.clockStartDisplay;
+  myClockStopDisplay = s.clockStopDisplay;
+  myClockAtLastUpdate = s.clockAtLastUpdate;
+  myClocksToEndOfScanLine = s.clocksToEndOfScanLine;
+  myScanlineCountForLastFrame = s.scanlineCountForLastFrame;
+  myCurrentScanline = s.currentScanline;
+  myVSYNCFinishClock = s.VSYNCFinishClock;
+  myFramePointer = myCurrentFrameBuffer + s.framePointer;
+  myPartialFrameFlag = s.partialFrameFlag;
+  myEnabledObjects = s.enabledObjects;
+  myVSYNC = s.VSYNC;  myVBLANK = s.VBLANK;
+  myNUSIZ0 = s.NUSIZ0;  myNUSIZ1 = s.NUSIZ1;
+  myCOLUP0 = s.COLUP0;  myCOLUP1 = s.COLUP1;
+  myCOLUPF = s.COLUPF;  myCOLUBK = s.COLUBK;
+  myCTRLPF = s.CTRLPF;
+  myPlayfieldPriorityAndScore = s.playfieldPriorityAndScore;
+  myREFP0 = s.REFP0;  myREFP1 = s.REFP1;
+  myPF = s.PF;
+  myGRP0 = s.GRP0;  myGRP1 = s.GRP1;  myDGRP0 = s.DGRP0;  myDGRP1 = s.DGRP1;
+  myENAM0 = s.ENAM0;  myENAM1 = s.ENAM1;
+  myENABL = s.ENABL;  myDENABL = s.DENABL;
+  myHMP0 = s.HMP0;  myHMP1 = s.HMP1;
+  myHMM0 = s.HMM0;  myHMM1 = s.HMM1;  myHMBL = s.HMBL;
+  myVDELP0 = s.VDELP0;  myVDELP1 = s.VDELP1;  myVDELBL = s.VDELBL;
+  myRESMP0 = s.RESMP0;  myRESMP1 = s.RESMP1;
+  myCollision = s.collision;
+  myPOSP0 = s.POSP0;  myPOSP1 = s.POSP1;
+  myPOSM0 = s.POSM0;  myPOSM1 = s.POSM1;  myPOSBL = s.POSBL;
+  myCurrentGRP0 = s.currentGRP0;  myCurrentGRP1 = s.currentGRP1;
+  myCurrentBLMask = (uInt8*) s.currentBLMask;
+  myCurrentM0Mask = (uInt8*) s.currentM0Mask;
+  myCurrentM1Mask = (uInt8*) s.currentM1Mask;
+  myCurrentP0Mask = (uInt8*) s.currentP0Mask;
+  myCurrentP1Mask = (uInt8*) s.currentP1Mask;
+  myCurrentPFMask = (uInt32*) s.currentPFMask;
+  myAUDV0 = s.AUDV0;  myAUDV1 = s.AUDV1;
+  myAUDC0 = s.AUDC0;  myAUDC1 = s.AUDC1;
+  myAUDF0 = s.AUDF0;  myAUDF1 = s.AUDF1;
+  myLastHMOVEClock = s.lastHMOVEClock;
+  myHMOVEBlankEnabled = s.HMOVEBlankEnabled;
+  myM0CosmicArkMotionEnabled = s.M0CosmicArkMotionEnabled;
+  myM0CosmicArkCounter = s.M0CosmicArkCounter;
+  myDumpEnabled = s.dumpEnabled;
+  myDumpDisabledCycle = s.dumpDisabledCycle;
+
+  return sizeof(s);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 TIA::missleMaskOffset(const uInt8* mask)
+{
+  if(mask == &TIATables::DisabledMaskTable[0])
+    return -1;
+  else
+    return mask - &TIATables::MissleMaskTable[0][0][0][0];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8* TIA::missleMask(Int32 offset)
+{
+  if(offset < 0)
+    return &TIATables::DisabledMaskTable[0];
+  else
+    return &TIATables::MissleMaskTable[0][0][0][0] + offset;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::update()
 {
@@ -508,9 +711,15 @@ void TIA::update()
 inline void TIA::startFrame()
 {
   // This stuff should only happen at the beginning of a new frame.
-  uInt8* tmp = myCurrentFrameBuffer;
-  myCurrentFrameBuffer = myPreviousFrameBuffer;
-  myPreviousFrameBuffer = tmp;
+  // A frame which won't be drawn leaves both buffers alone, so the
+  // last drawn frame stays current.
+  myRenderingEnabled = myRenderingRequested;
+  if(myRenderingEnabled)
+  {
+    uInt8* tmp = myCurrentFrameBuffer;
+    myCurrentFrameBuffer = myPreviousFrameBuffer;
+    myPreviousFrameBuffer = tmp;
+  }
 
   // Remember the number of clocks which have passed on the current scanline
   // so that we can adjust the frame's starting clock by this amount.  This
@@ -676,11 +885,22 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
   // Calculate the ending frame pointer value
   uInt8* ending = myFramePointer + clocksToUpdate;
 
+  // Frames which aren't drawn only need their collisions
+  if(!myRenderingEnabled)
+  {
+    if(!(myVBLANK & 0x02))
+      updateFrameScanlineCollisions(clocksToUpdate, hpos);
+  }
   // See if we're in the vertical blank region
-  if(myVBLANK & 0x02)
+  else if(myVBLANK & 0x02)
   {
     memset(myFramePointer, 0, clocksToUpdate);
   }
+  // Use the packed masks if they've been requested
+  else if(myBitplaneRendering)
+  {
+    updateFrameScanlineBitplane(clocksToUpdate, hpos);
+  }
   // Handle all other possible combinations
   else
   {
@@ -1259,6 +1479,201 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
   myFramePointer = ending;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::loadBitplanes(Bitplanes& planes, const uInt8* mask)
+{
+  memset(planes.plane, 0, sizeof(planes.plane));
+  for(uInt32 x = 0; x < 160; ++x)
+    for(uInt32 n = 0; n < 8; ++n)
+      if(mask[x] & (1 << n))
+        planes.plane[n][x >> 6] |= (uInt64)1 << (x & 63);
+
+  planes.source = mask;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::loadBitplanes(Bitplanes& planes, const uInt32* mask)
+{
+  memset(planes.plane, 0, sizeof(planes.plane));
+  for(uInt32 x = 0; x < 160; ++x)
+    for(uInt32 n = 0; n < 20; ++n)
+      if(mask[x] & (1 << n))
+        planes.plane[n][x >> 6] |= (uInt64)1 << (x & 63);
+
+  planes.source = mask;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline void TIA::selectBitplanes(const Bitplanes& planes, uInt32 graphics,
+                                 uInt64* pixels)
+{
+  pixels[0] = pixels[1] = pixels[2] = 0;
+  for(uInt32 n = 0; graphics != 0; ++n, graphics >>= 1)
+  {
+    if(graphics & 0x01)
+    {
+      pixels[0] |= planes.plane[n][0];
+      pixels[1] |= planes.plane[n][1];
+      pixels[2] |= planes.plane[n][2];
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::collideBitplanes(uInt32 clocksToUpdate, uInt32 hpos,
+                           uInt64 pixels[NumObjects][3])
+{
+  if(myCurrentP0Mask != myP0Bitplanes.source)
+    loadBitplanes(myP0Bitplanes, myCurrentP0Mask);
+  if(myCurrentP1Mask != myP1Bitplanes.source)
+    loadBitplanes(myP1Bitplanes, myCurrentP1Mask);
+  if(myCurrentM0Mask != myM0Bitplanes.source)
+    loadBitplanes(myM0Bitplanes, myCurrentM0Mask);
+  if(myCurrentM1Mask != myM1Bitplanes.source)
+    loadBitplanes(myM1Bitplanes, myCurrentM1Mask);
+  if(myCurrentBLMask != myBLBitplanes.source)
+    loadBitplanes(myBLBitplanes, myCurrentBLMask);
+  if(myCurrentPFMask != myPFBitplanes.source)
+    loadBitplanes(myPFBitplanes, myCurrentPFMask);
+
+  selectBitplanes(myP0Bitplanes, myCurrentGRP0, pixels[ObjectP0]);
+  selectBitplanes(myP1Bitplanes, myCurrentGRP1, pixels[ObjectP1]);
+  selectBitplanes(myM0Bitplanes, (myEnabledObjects & M0Bit) ? 1 : 0,
+                  pixels[ObjectM0]);
+  selectBitplanes(myM1Bitplanes, (myEnabledObjects & M1Bit) ? 1 : 0,
+                  pixels[ObjectM1]);
+  selectBitplanes(myBLBitplanes, (myEnabledObjects & BLBit) ? 1 : 0,
+                  pixels[ObjectBL]);
+  selectBitplanes(myPFBitplanes, myPF, pixels[ObjectPF]);
+
+  // Only keep the pixels being updated, and find out which objects
+  // have any pixels there at all
+  uInt32 ending = hpos + clocksToUpdate;
+  uInt64 window[3];
+  for(uInt32 w = 0; w < 3; ++w)
+  {
+    uInt32 first = w * 64, last = first + 64;
+    uInt64 m = ~(uInt64)0;
+    if(hpos > first)
+      m = (hpos >= last) ? 0 : (m << (hpos - first));
+    if(ending < last)
+      m &= (ending <= first) ? 0 : (~(uInt64)0 >> (last - ending));
+    window[w] = m;
+  }
+
+  uInt8 visible = 0;
+  for(uInt32 i = 0; i < NumObjects; ++i)
+  {
+    pixels[i][0] &= window[0];
+    pixels[i][1] &= window[1];
+    pixels[i][2] &= window[2];
+    if(pixels[i][0] | pixels[i][1] | pixels[i][2])
+      visible |= 1 << i;
+  }
+
+  // Each pair of objects which overlap anywhere sets its collision bit
+  for(uInt32 i = 0; i < NumObjects; ++i)
+  {
+    if(!(visible & (1 << i)))
+      continue;
+
+    for(uInt32 j = i + 1; j < NumObjects; ++j)
+    {
+      if((visible & (1 << j)) &&
+         ((pixels[i][0] & pixels[j][0]) | (pixels[i][1] & pixels[j][1]) |
+          (pixels[i][2] & pixels[j][2])))
+        myCollision |= TIATables::CollisionTable[(1 << i) | (1 << j)];
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::updateFrameScanlineBitplane(uInt32 clocksToUpdate, uInt32 hpos)
+{
+  uInt64 pixels[NumObjects][3];
+  collideBitplanes(clocksToUpdate, hpos, pixels);
+
+  // Resolve priorities into the two bits of the color index for each
+  // pixel (0 = COLUBK, 1 = COLUPF, 2 = COLUP0, 3 = COLUP1), exactly as
+  // the priority encoder does; in score mode the playfield uses the
+  // player colors, so pixels 0 - 79 are in the left half of the screen
+  static const uInt64 leftHalf[3] = { ~(uInt64)0, 0xFFFF, 0 };
+  uInt64 low[3], high[3];
+
+  // The priority encoder ignores the score bit when the playfield has
+  // priority, but when the playfield is the only object enabled the
+  // standard renderer draws it in the score colors anyway
+  bool priority = (myPlayfieldPriorityAndScore & PriorityBit) &&
+      !(myEnabledObjects == PFBit && (myPlayfieldPriorityAndScore & ScoreBit));
+
+  for(uInt32 w = 0; w < 3; ++w)
+  {
+    uInt64 pm0 = pixels[ObjectP0][w] | pixels[ObjectM0][w];
+    uInt64 pm1 = pixels[ObjectP1][w] | pixels[ObjectM1][w];
+    uInt64 pfbl = pixels[ObjectPF][w] | pixels[ObjectBL][w];
+    uInt64 c1, c2, c3;
+
+    if(priority)
+    {
+      c1 = pfbl;
+      c2 = pm0 & ~c1;
+      c3 = pm1 & ~c1 & ~pm0;
+    }
+    else
+    {
+      uInt64 scoreLeft = 0, scoreRight = 0;
+      if(myPlayfieldPriorityAndScore & ScoreBit)
+      {
+        scoreLeft = pixels[ObjectPF][w] & leftHalf[w];
+        scoreRight = pixels[ObjectPF][w] & ~leftHalf[w];
+      }
+
+      c2 = pm0 | scoreLeft;
+      c3 = (pm1 | scoreRight) & ~c2;
+      c1 = pfbl & ~c2 & ~c3;
+    }
+
+    low[w] = c1 | c3;
+    high[w] = c2 | c3;
+  }
+
+  // Now expand the color indices into the frame buffer, filling runs of
+  // background directly
+  uInt32 ending = hpos + clocksToUpdate;
+  uInt8 color[4] = {
+    (uInt8) myColor[0], (uInt8) myColor[1],
+    (uInt8) myColor[2], (uInt8) myColor[3]
+  };
+  for(uInt32 x = hpos; x < ending; )
+  {
+    uInt32 w = x >> 6;
+    uInt32 count = BSPF_min(64 - (x & 63), ending - x);
+    uInt64 l = low[w] >> (x & 63);
+    uInt64 h = high[w] >> (x & 63);
+
+    if(!(l | h))
+    {
+      memset(myFramePointer, color[0], count);
+      myFramePointer += count;
+    }
+    else
+    {
+      for(uInt32 i = 0; i < count; ++i, l >>= 1, h >>= 1)
+        *myFramePointer++ = color[(l & 0x01) | ((h & 0x01) << 1)];
+    }
+    x += count;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::updateFrameScanlineCollisions(uInt32 clocksToUpdate, uInt32 hpos)
+{
+  uInt64 pixels[NumObjects][3];
+  collideBitplanes(clocksToUpdate, hpos, pixels);
+
+  myFramePointer += clocksToUpdate;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::updateFrame(Int32 clock)
 {
@@ -1332,7 +1747,8 @@ void TIA::updateFrame(Int32 clock)
         (clocksFromStartOfScanLine < (HBLANK + 8)))
     {
       Int32 blanks = (HBLANK + 8) - clocksFromStartOfScanLine;
-      memset(oldFramePointer, 0, blanks);
+      if(myRenderingEnabled)
+        memset(oldFramePointer, 0, blanks);
 
       if((clocksToUpdate + clocksFromStartOfScanLine) >= (HBLANK + 8))
       {
@@ -1359,7 +1775,7 @@ void TIA::updateFrame(Int32 clock)
       if(myM0CosmicArkMotionEnabled)
       {
         // Movement table associated with the bug
-        static uInt32 m[4] = {18, 33, 0, 17};
+        static const uInt32 m[4] = {18, 33, 0, 17};
 
         myM0CosmicArkCounter = (myM0CosmicArkCounter + 1) & 3;
         myPOSM0 -= m[myM0CosmicArkCounter];
@@ -1552,7 +1968,7 @@ void TIA::poke(uInt16 addr, uInt8 value)
   // See if this is a poke to a PF register
   if(delay == -1)
   {
-    static uInt32 d[4] = {4, 5, 2, 3};
+    static const uInt32 d[4] = {4, 5, 2, 3};
     Int32 x = ((clock - myClockWhenFrameStarted) % 228);
     delay = d[(x / 3) & 3];
   }
@@ -2026,42 +2442,48 @@ void TIA::poke(uInt16 addr, uInt8 value)
     case AUDC0:   // Audio control 0
     {
       myAUDC0 = value & 0x0f;
-      mySound.set(addr, value, mySystem->cycles());
+      if(mySoundEnabled)
+        mySound.set(addr, value, mySystem->cycles());
       break;
     }
   
     case AUDC1:   // Audio control 1
     {
       myAUDC1 = value & 0x0f;
-      mySound.set(addr, value, mySystem->cycles());
+      if(mySoundEnabled)
+        mySound.set(addr, value, mySystem->cycles());
       break;
     }
   
     case AUDF0:   // Audio frequency 0
     {
       myAUDF0 = value & 0x1f;
-      mySound.set(addr, value, mySystem->cycles());
+      if(mySoundEnabled)
+        mySound.set(addr, value, mySystem->cycles());
       break;
     }
   
     case AUDF1:   // Audio frequency 1
     {
       myAUDF1 = value & 0x1f;
-      mySound.set(addr, value, mySystem->cycles());
+      if(mySoundEnabled)
+        mySound.set(addr, value, mySystem->cycles());
       break;
     }
   
     case AUDV0:   // Audio volume 0
     {
       myAUDV0 = value & 0x0f;
-      mySound.set(addr, value, mySystem->cycles());
+      if(mySoundEnabled)
+        mySound.set(addr, value, mySystem->cycles());
       break;
     }
   
     case AUDV1:   // Audio volume 1
     {
       myAUDV1 = value & 0x0f;
-      mySound.set(addr, value, mySystem->cycles());
+      if(mySoundEnabled)
+        mySound.set(addr, value, mySystem->cycles());
       break;
     }
 
@@ -120,6 +120,31 @@ class TIA : public Device
     */
     string name() const { return "TIA"; }
 
+    /**
+      Answers the number of bytes used by cloneState().
+
+      @return The size of the state snapshot
+    */
+    uInt32 stateSize() const;
+
+    /**
+      Copies the current state of this device to the given buffer
+      (see Device::cloneState()).
+
+      @param state  The buffer of stateSize() bytes to copy the state to
+      @return  The number of bytes copied (always stateSize())
+    */
+    uInt32 cloneState(uInt8* state) const;
+
+    /**
+      Restores the state of this device from a snapshot which was taken
+      by cloneState().
+
+      @param state  The buffer to restore the state from
+      @return  The number of bytes used from the buffer
+    */
+    uInt32 restoreState(const uInt8* state);
+
     /**
       Get the byte at the specified address
 
@@ -170,6 +195,34 @@ class TIA : public Device
     */
     void enableAutoFrame(bool mode) { myAutoFrameEnabled = mode; }
 
+    /**
+      Enables/disables drawing of the frame buffer.  When disabled, the
+      TIA still tracks all object positions and collisions exactly, but
+      never writes to the frame buffers, and the current frame buffer
+      keeps the last frame which was drawn.  This is meant for frames
+      which will never be displayed (frame skipping, fast-forward, etc).
+      The change takes effect at the start of the next frame.
+
+      @param mode  Whether to enable or disable drawing of frames
+    */
+    void enableRendering(bool mode) { myRenderingRequested = mode; }
+
+    /**
+      Answers whether the frame currently being emulated is being drawn.
+    */
+    bool isRendering() const { return myRenderingEnabled; }
+
+    /**
+      Enables/disables passing sound register writes on to the sound
+      device.  While disabled the sound device is left completely alone,
+      and loading a state doesn't touch it either, so frames can be
+      emulated speculatively and then thrown away (see run-ahead in the
+      FrameBuffer) without disturbing the sound being played.
+
+      @param mode  Whether to enable or disable sound output
+    */
+    void enableSound(bool mode) { mySoundEnabled = mode; }
+
     /**
       Answers the current color clock we've gotten to on this scanline.
 
@@ -204,6 +257,11 @@ class TIA : public Device
     */
     void enableBit(TIABit b, bool mode) { myBitEnabled[b] = mode ? 0xff : 0x00; }
 
+    /**
+      Answer whether the specified TIA bit is enabled.
+    */
+    bool bitEnabled(TIABit b) const { return myBitEnabled[b] != 0x00; }
+
     /**
       Toggles the specified TIA bit.
 
@@ -243,6 +301,48 @@ class TIA : public Device
     // Update the current frame buffer up to one scanline
     void updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos);
 
+    // Update the current frame buffer up to one scanline, using packed
+    // masks for the objects instead of walking the mask tables per pixel
+    void updateFrameScanlineBitplane(uInt32 clocksToUpdate, uInt32 hpos);
+
+    // Update the collision latches up to one scanline, without drawing
+    void updateFrameScanlineCollisions(uInt32 clocksToUpdate, uInt32 hpos);
+
+  private:
+    // Graphical objects, in the order of their bits in
+    // TIATables::CollisionTable
+    enum { ObjectP0, ObjectM0, ObjectP1, ObjectM1, ObjectBL, ObjectPF,
+           NumObjects };
+
+    /**
+      The pixels of a graphical object for a whole scanline, packed one
+      bit per pixel (pixel x is bit x % 64 of word x / 64).  Plane n holds
+      the pixels which are drawn when bit n of the object's graphics (the
+      GRPx register, the playfield register or the enable bit) is set.
+      The planes only depend on the mask table they were built from, so
+      they're kept until the object uses a different mask.
+    */
+    struct Bitplanes
+    {
+      const void* source;
+      uInt64 plane[20][3];
+    };
+
+    // Rebuild the planes from a player, missle or ball mask table
+    static void loadBitplanes(Bitplanes& planes, const uInt8* mask);
+
+    // Rebuild the planes from a playfield mask table
+    static void loadBitplanes(Bitplanes& planes, const uInt32* mask);
+
+    // Get the pixels drawn for the given graphics
+    static void selectBitplanes(const Bitplanes& planes, uInt32 graphics,
+                                uInt64* pixels);
+
+    // Get the pixels of each object which are within the given part of
+    // the scanline, and latch the collisions between them
+    void collideBitplanes(uInt32 clocksToUpdate, uInt32 hpos,
+                          uInt64 pixels[NumObjects][3]);
+
     // Update the current frame buffer to the specified color clock
     void updateFrame(Int32 clock);
 
@@ -264,6 +364,11 @@ class TIA : public Device
     // Convert resistance from ports to dumped value
     uInt8 dumpedInputPort(int resistance);
 
+    // Convert a missle mask to and from an offset into the mask tables,
+    // for saving and loading state
+    static Int32 missleMaskOffset(const uInt8* mask);
+    static uInt8* missleMask(Int32 offset);
+
   private:
     // Console the TIA is associated with
     Console& myConsole;
@@ -487,6 +592,26 @@ class TIA : public Device
     // The framerate currently in use by the Console
     float myFramerate;
 
+    // Indicates if the bitplane renderer is used instead of the mask tables
+    bool myBitplaneRendering;
+
+    // Packed masks used by the bitplane renderer
+    Bitplanes myP0Bitplanes;
+    Bitplanes myP1Bitplanes;
+    Bitplanes myM0Bitplanes;
+    Bitplanes myM1Bitplanes;
+    Bitplanes myBLBitplanes;
+    Bitplanes myPFBitplanes;
+
+    // Indicates if the current frame is being drawn, and if the next
+    // one should be (see enableRendering())
+    bool myRenderingEnabled;
+    bool myRenderingRequested;
+
+    // Indicates if sound register writes go to the sound device
+    // (see enableSound())
+    bool mySoundEnabled;
+
   private:
     // Copy constructor isn't supported by this class so make it private
     TIA(const TIA&);
@@ -16,9 +16,138 @@
 // $Id: TIASnd.cxx,v 1.8 2009-01-01 18:13:37 stephena Exp $
 //============================================================================
 
+#include <cstring>
+
 #include "System.hxx"
 #include "TIASnd.hxx"
 
+// The state of a channel's polynomial counters, P5 in bits 4-8 and P4 in
+// bits 0-3 (only the bits the counters really have), after one pulse of its
+// frequency divider, for each AUDC value and state
+static uInt16 ourNextState[16][512];
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Clock the polynomial counters of a channel for one pulse of its frequency
+// divider; this is only used to fill in ourNextState
+static void clockPolys(uInt8 audc, uInt8& p4, uInt8& p5)
+{
+  switch(audc)
+  {
+    case 0x00:    // Set to 1
+    case 0x0b:    // Set last 4 bits to 1
+    {
+      // Shift a 1 into the 4-bit register each clock
+      p4 = (p4 << 1) | 0x01;
+      break;
+    }
+
+    case 0x01:    // 4 bit poly
+    {
+      // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
+      p4 = (p4 & 0x0f) ?
+          ((p4 << 1) | (((p4 & 0x08) ? 1 : 0) ^ ((p4 & 0x04) ? 1 : 0))) : 1;
+      break;
+    }
+
+    case 0x02:    // div 31 -> 4 bit poly
+    case 0x03:    // 5 bit poly -> 4 bit poly
+    case 0x06:    // div 31 -> div 2
+    case 0x07:    // 5 bit poly -> div 2
+    case 0x0a:    // div 31
+    case 0x0e:    // div 31 -> div 6
+    case 0x0f:    // poly 5 -> div 6
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+          ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^ ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // Either the divide-by 31 with length 13:18, or P5 itself, clocks P4
+      bool div31 = audc == 0x02 || audc == 0x06 || audc == 0x0a ||
+                   audc == 0x0e;
+      if(div31 ? ((p5 & 0x0f) != 0x08) : !(p5 & 0x10))
+        break;
+
+      if(audc == 0x02 || audc == 0x03)
+      {
+        // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
+        p4 = (p4 & 0x0f) ?
+            ((p4 << 1) | (((p4 & 0x08) ? 1 : 0) ^ ((p4 & 0x04) ? 1 : 0))) : 1;
+      }
+      else if(audc == 0x06 || audc == 0x07)
+      {
+        // Clock P4 toggling the lower bit (divide by 2)
+        p4 = (p4 << 1) | ((p4 & 0x01) ? 0 : 1);
+      }
+      else if(audc == 0x0a)
+      {
+        // Feed bit 4 of P5 into P4 (this will toggle back and forth)
+        p4 = (p4 << 1) | ((p5 & 0x10) ? 1 : 0);
+      }
+      else
+      {
+        // Use 4-bit register to generate sequence 000111000111
+        p4 = (~p4 << 1) | ((!(!(p4 & 4) && ((p4 & 7)))) ? 0 : 1);
+      }
+      break;
+    }
+
+    case 0x04:    // div 2
+    case 0x05:    // div 2
+    {
+      // Clock P4 toggling the lower bit (divide by 2)
+      p4 = (p4 << 1) | ((p4 & 0x01) ? 0 : 1);
+      break;
+    }
+
+    case 0x08:    // 9 bit poly
+    {
+      // Clock P5 & P4 as a standard 9-bit LSFR taps at 8 & 4
+      p5 = ((p5 & 0x1f) || (p4 & 0x0f)) ?
+          ((p5 << 1) | (((p4 & 0x08) ? 1 : 0) ^ ((p5 & 0x10) ? 1 : 0))) : 1;
+      p4 = (p4 << 1) | ((p5 & 0x20) ? 1 : 0);
+      break;
+    }
+
+    case 0x09:    // 5 bit poly
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+          ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^ ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // Clock value out of P5 into P4 with no modification
+      p4 = (p4 << 1) | ((p5 & 0x20) ? 1 : 0);
+      break;
+    }
+
+    case 0x0c:    // div 6
+    case 0x0d:    // div 6
+    {
+      // Use 4-bit register to generate sequence 000111000111
+      p4 = (~p4 << 1) | ((!(!(p4 & 4) && ((p4 & 7)))) ? 0 : 1);
+      break;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The table never changes once computed, so it's computed once, before
+// main() is entered, the same as the TIA tables
+static struct TIASoundTablesInitializer
+{
+  TIASoundTablesInitializer()
+  {
+    for(uInt32 audc = 0; audc < 16; ++audc)
+    {
+      for(uInt32 state = 0; state < 512; ++state)
+      {
+        uInt8 p4 = state & 0x0f, p5 = state >> 4;
+        clockPolys(audc, p4, p5);
+        ourNextState[audc][state] = ((p5 & 0x1f) << 4) | (p4 & 0x0f);
+      }
+    }
+  }
+} ourTIASoundTablesInitializer;
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TIASound::TIASound(Int32 outputFrequency, Int32 tiaFrequency, uInt32 channels)
   : myOutputFrequency(outputFrequency),
@@ -40,10 +169,11 @@ TIASound::~TIASound()
 void TIASound::reset()
 {
   myAUDC[0] = myAUDC[1] = myAUDF[0] = myAUDF[1] = myAUDV[0] = myAUDV[1] = 0;
-  myP4[0] = myP5[0] = myP4[1] = myP5[1] = 1;
+  myPolys[0] = myPolys[1] = (1 << 4) | 1;
   myFreqDiv[0].set(0);
   myFreqDiv[1].set(0);
   myOutputCounter = 0;
+  updateVolumes();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -68,6 +198,7 @@ void TIASound::channels(uInt32 number)
 void TIASound::clipVolume(bool clip)
 {
   myVolumeClip = clip ? 128 : 0;
+  updateVolumes();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -95,10 +226,12 @@ void TIASound::set(uInt16 address, uInt8 value)
 
     case 0x19:    // AUDV0
       myAUDV[0] = value & 0x0f;
+      updateVolumes();
       break;
 
     case 0x1a:    // AUDV1
       myAUDV[1] = value & 0x0f;
+      updateVolumes();
       break;
 
     default:
@@ -138,245 +271,128 @@ uInt8 TIASound::get(uInt16 address)
 void TIASound::volume(uInt32 percent)
 {
   if((percent >= 0) && (percent <= 100))
+  {
     myVolumePercentage = percent;
+    updateVolumes();
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIASound::process(uInt8* buffer, uInt32 samples)
+void TIASound::updateVolumes()
 {
   Int32 v0 = ((myAUDV[0] << 2) * myVolumePercentage) / 100;
   Int32 v1 = ((myAUDV[1] << 2) * myVolumePercentage) / 100;
 
-  // Loop until the sample buffer is full
-  while(samples > 0)
+  // Indexed by the outputs of the two channels (bit 0 for channel 0)
+  for(uInt32 i = 0; i < 4; ++i)
   {
-    // Process both sound channels
-    for(uInt32 c = 0; c < 2; ++c)
-    {
-      // Update P4 & P5 registers for channel if freq divider outputs a pulse
-      if((myFreqDiv[c].clock()))
-      {
-        switch(myAUDC[c])
-        {
-          case 0x00:    // Set to 1
-          {
-            // Shift a 1 into the 4-bit register each clock
-            myP4[c] = (myP4[c] << 1) | 0x01;
-            break;
-          }
-
-          case 0x01:    // 4 bit poly
-          {
-            // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
-            myP4[c] = (myP4[c] & 0x0f) ? 
-                ((myP4[c] << 1) | (((myP4[c] & 0x08) ? 1 : 0) ^
-                ((myP4[c] & 0x04) ? 1 : 0))) : 1;
-            break;
-          }
-
-          case 0x02:    // div 31 -> 4 bit poly
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // This does the divide-by 31 with length 13:18
-            if((myP5[c] & 0x0f) == 0x08)
-            {
-              // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
-              myP4[c] = (myP4[c] & 0x0f) ? 
-                  ((myP4[c] << 1) | (((myP4[c] & 0x08) ? 1 : 0) ^
-                  ((myP4[c] & 0x04) ? 1 : 0))) : 1;
-            }
-            break;
-          }
-
-          case 0x03:    // 5 bit poly -> 4 bit poly
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // P5 clocks the 4 bit poly
-            if(myP5[c] & 0x10)
-            {
-              // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
-              myP4[c] = (myP4[c] & 0x0f) ? 
-                  ((myP4[c] << 1) | (((myP4[c] & 0x08) ? 1 : 0) ^
-                  ((myP4[c] & 0x04) ? 1 : 0))) : 1;
-            }
-            break;
-          }
-
-          case 0x04:    // div 2
-          {
-            // Clock P4 toggling the lower bit (divide by 2) 
-            myP4[c] = (myP4[c] << 1) | ((myP4[c] & 0x01) ? 0 : 1);
-            break;
-          }
-
-          case 0x05:    // div 2
-          {
-            // Clock P4 toggling the lower bit (divide by 2) 
-            myP4[c] = (myP4[c] << 1) | ((myP4[c] & 0x01) ? 0 : 1);
-            break;
-          }
-
-          case 0x06:    // div 31 -> div 2
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // This does the divide-by 31 with length 13:18
-            if((myP5[c] & 0x0f) == 0x08)
-            {
-              // Clock P4 toggling the lower bit (divide by 2) 
-              myP4[c] = (myP4[c] << 1) | ((myP4[c] & 0x01) ? 0 : 1);
-            }
-            break;
-          }
-
-          case 0x07:    // 5 bit poly -> div 2
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // P5 clocks the 4 bit register
-            if(myP5[c] & 0x10)
-            {
-              // Clock P4 toggling the lower bit (divide by 2) 
-              myP4[c] = (myP4[c] << 1) | ((myP4[c] & 0x01) ? 0 : 1);
-            }
-            break;
-          }
-
-          case 0x08:    // 9 bit poly
-          {
-            // Clock P5 & P4 as a standard 9-bit LSFR taps at 8 & 4
-            myP5[c] = ((myP5[c] & 0x1f) || (myP4[c] & 0x0f)) ?
-              ((myP5[c] << 1) | (((myP4[c] & 0x08) ? 1 : 0) ^
-              ((myP5[c] & 0x10) ? 1 : 0))) : 1;
-            myP4[c] = (myP4[c] << 1) | ((myP5[c] & 0x20) ? 1 : 0);
-            break;
-          }
-
-          case 0x09:    // 5 bit poly
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // Clock value out of P5 into P4 with no modification
-            myP4[c] = (myP4[c] << 1) | ((myP5[c] & 0x20) ? 1 : 0);
-            break;
-          }
-
-          case 0x0a:    // div 31
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // This does the divide-by 31 with length 13:18
-            if((myP5[c] & 0x0f) == 0x08)
-            {
-              // Feed bit 4 of P5 into P4 (this will toggle back and forth)
-              myP4[c] = (myP4[c] << 1) | ((myP5[c] & 0x10) ? 1 : 0);
-            }
-            break;
-          }
-
-          case 0x0b:    // Set last 4 bits to 1
-          {
-            // A 1 is shifted into the 4-bit register each clock
-            myP4[c] = (myP4[c] << 1) | 0x01;
-            break;
-          }
-
-          case 0x0c:    // div 6
-          {
-            // Use 4-bit register to generate sequence 000111000111
-            myP4[c] = (~myP4[c] << 1) |
-                ((!(!(myP4[c] & 4) && ((myP4[c] & 7)))) ? 0 : 1);
-            break;
-          }
+    Int32 l = (i & 1) ? v0 : 0, r = (i & 2) ? v1 : 0;
+    myMonoLevel[i] = l + r + myVolumeClip;
+    myStereoLevel[i][0] = l + myVolumeClip;
+    myStereoLevel[i][1] = r + myVolumeClip;
+  }
+}
 
-          case 0x0d:    // div 6
-          {
-            // Use 4-bit register to generate sequence 000111000111
-            myP4[c] = (~myP4[c] << 1) |
-                ((!(!(myP4[c] & 4) && ((myP4[c] & 7)))) ? 0 : 1);
-            break;
-          }
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::process(uInt8* buffer, uInt32 samples)
+{
+  const uInt16* next0 = ourNextState[myAUDC[0]];
+  const uInt16* next1 = ourNextState[myAUDC[1]];
+  uInt16 poly0 = myPolys[0], poly1 = myPolys[1];
 
-          case 0x0e:    // div 31 -> div 6
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // This does the divide-by 31 with length 13:18
-            if((myP5[c] & 0x0f) == 0x08)
-            {
-              // Use 4-bit register to generate sequence 000111000111
-              myP4[c] = (~myP4[c] << 1) |
-                  ((!(!(myP4[c] & 4) && ((myP4[c] & 7)))) ? 0 : 1);
-            }
-            break;
-          }
+  // The output of each channel is bit 3 of its P4, which only changes when
+  // its frequency divider pulses
+  #define OUTPUTS (((poly0 >> 3) & 1) | ((poly1 >> 2) & 2))
 
-          case 0x0f:    // poly 5 -> div 6
+  if(myOutputFrequency == myTIAFrequency && myOutputCounter < myTIAFrequency)
+  {
+    // Every TIA clock makes one sample, so the output is constant for runs
+    // of samples between divider pulses
+    while(samples > 0)
+    {
+      uInt32 run = BSPF_min(BSPF_min(myFreqDiv[0].clocksToPulse(),
+                                     myFreqDiv[1].clocksToPulse()), samples);
+      if(run > 0)
+      {
+        uInt32 outputs = OUTPUTS;
+        if(myChannels == 1)
+        {
+          memset(buffer, myMonoLevel[outputs], run);
+          buffer += run;
+        }
+        else
+        {
+          uInt8 l = myStereoLevel[outputs][0], r = myStereoLevel[outputs][1];
+          for(uInt32 i = 0; i < run; ++i)
           {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // Use poly 5 to clock 4-bit div register
-            if(myP5[c] & 0x10)
-            {
-              // Use 4-bit register to generate sequence 000111000111
-              myP4[c] = (~myP4[c] << 1) |
-                  ((!(!(myP4[c] & 4) && ((myP4[c] & 7)))) ? 0 : 1);
-            }
-            break;
+            *(buffer++) = l;
+            *(buffer++) = r;
           }
         }
+        myFreqDiv[0].skip(run);
+        myFreqDiv[1].skip(run);
+        samples -= run;
+        if(samples == 0)
+          break;
       }
-    }
 
-    myOutputCounter += myOutputFrequency;
-  
-    if(myChannels == 1)
-    {
-      // Handle mono sample generation
-      while((samples > 0) && (myOutputCounter >= myTIAFrequency))
+      // The clock on which at least one of the dividers pulses
+      if(myFreqDiv[0].clock())
+        poly0 = next0[poly0];
+      if(myFreqDiv[1].clock())
+        poly1 = next1[poly1];
+
+      uInt32 outputs = OUTPUTS;
+      if(myChannels == 1)
+        *(buffer++) = myMonoLevel[outputs];
+      else
       {
-        *(buffer++) = (((myP4[0] & 8) ? v0 : 0) + 
-            ((myP4[1] & 8) ? v1 : 0)) + myVolumeClip;
-        myOutputCounter -= myTIAFrequency;
-        samples--;
+        *(buffer++) = myStereoLevel[outputs][0];
+        *(buffer++) = myStereoLevel[outputs][1];
       }
+      --samples;
     }
-    else
+  }
+  else
+  {
+    // Loop until the sample buffer is full
+    while(samples > 0)
     {
-      // Handle stereo sample generation
-      while((samples > 0) && (myOutputCounter >= myTIAFrequency))
+      // Update the polynomial counters of each channel if its frequency
+      // divider outputs a pulse
+      if(myFreqDiv[0].clock())
+        poly0 = next0[poly0];
+      if(myFreqDiv[1].clock())
+        poly1 = next1[poly1];
+
+      myOutputCounter += myOutputFrequency;
+
+      uInt32 outputs = OUTPUTS;
+      if(myChannels == 1)
+      {
+        // Handle mono sample generation
+        while((samples > 0) && (myOutputCounter >= myTIAFrequency))
+        {
+          *(buffer++) = myMonoLevel[outputs];
+          myOutputCounter -= myTIAFrequency;
+          samples--;
+        }
+      }
+      else
       {
-        *(buffer++) = ((myP4[0] & 8) ? v0 : 0) + myVolumeClip;
-        *(buffer++) = ((myP4[1] & 8) ? v1 : 0) + myVolumeClip;
-        myOutputCounter -= myTIAFrequency;
-        samples--;
+        // Handle stereo sample generation
+        while((samples > 0) && (myOutputCounter >= myTIAFrequency))
+        {
+          *(buffer++) = myStereoLevel[outputs][0];
+          *(buffer++) = myStereoLevel[outputs][1];
+          myOutputCounter -= myTIAFrequency;
+          samples--;
+        }
       }
     }
   }
+  #undef OUTPUTS
+
+  myPolys[0] = poly0;
+  myPolys[1] = poly1;
 }
@@ -25,6 +25,11 @@
   This class implements a fairly accurate emulation of the TIA sound
   hardware.
 
+  The polynomial counters of each channel only have 512 states between
+  them, so the next state for every AUDC value and state is worked out
+  once, and samples are generated in runs between frequency divider
+  pulses, during which the output can't change.
+
   @author  Bradford W. Mott
   @version $Id: TIASnd.hxx,v 1.8 2009-01-01 18:13:37 stephena Exp $
 */
@@ -99,6 +104,13 @@ class TIASound
     */
     void volume(uInt32 percent);
 
+  private:
+    /**
+      Work out the sample values for each combination of channel outputs,
+      from the volume registers and settings.
+    */
+    void updateVolumes();
+
   private:
     /**
       Frequency divider class which outputs 1 after "divide-by" clocks. This
@@ -127,6 +139,19 @@ class TIASound
           return false;
         }
 
+        // Answer how many times clock() can be called before it pulses
+        uInt32 clocksToPulse() const
+        {
+          return myCounter < myDivideByValue ? myDivideByValue - myCounter : 0;
+        }
+
+        // The same as calling clock() the given number of times, which must
+        // be no more than clocksToPulse()
+        void skip(uInt32 clocks)
+        {
+          myCounter += clocks;
+        }
+
       private:
         uInt32 myDivideByValue;
         uInt32 myCounter;
@@ -138,8 +163,7 @@ class TIASound
     uInt8 myAUDV[2];
 
     FreqDiv myFreqDiv[2];    // Frequency dividers
-    uInt8 myP4[2];           // 4-bit register LFSR (lower 4 bits used)
-    uInt8 myP5[2];           // 5-bit register LFSR (lower 5 bits used)
+    uInt16 myPolys[2];       // 5-bit LFSR (bits 4-8) and 4-bit LFSR (bits 0-3)
 
     Int32  myOutputFrequency;
     Int32  myTIAFrequency;
@@ -147,6 +171,11 @@ class TIASound
     Int32  myOutputCounter;
     uInt32 myVolumePercentage;
     uInt8  myVolumeClip;
+
+    // Sample values for each combination of channel outputs (bit 0 being
+    // channel 0), mixed for mono and separate for stereo
+    uInt8 myMonoLevel[4];
+    uInt8 myStereoLevel[4][2];
 };
 
 #endif
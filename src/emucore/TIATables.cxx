@@ -642,3 +642,12 @@ uInt8 TIATables::PlayerReflectTable[256];
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 TIATables::PlayfieldTable[2][160];
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The tables never change once computed, so they're computed once, before
+// main() is entered, instead of by every TIA; a TIA being created would
+// otherwise rewrite them underneath consoles running in other threads
+static struct TIATablesInitializer
+{
+  TIATablesInitializer() { TIATables::computeAllTables(); }
+} ourTIATablesInitializer;
@@ -108,7 +108,8 @@ class TIATables
 {
   public:
     /**
-      Compute all static tables used by the TIA
+      Compute all static tables used by the TIA.  This is done once at
+      program startup (see TIATables.cxx), and needn't be called again.
     */
     static void computeAllTables();
 
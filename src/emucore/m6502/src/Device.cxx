@@ -16,6 +16,8 @@
 // $Id: Device.cxx,v 1.6 2009-01-01 18:13:38 stephena Exp $
 //============================================================================
 
+#include <cstring>
+
 #include "Device.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -35,3 +37,41 @@ void Device::systemCyclesReset()
   // By default I do nothing when my system resets its cycle counter
 }
 
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Device::stateSize() const
+{
+  Serializer out;
+  out.openBuffer();
+  save(out);
+
+  return sizeof(uInt32) + out.bufferSize();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Device::cloneState(uInt8* state) const
+{
+  // The saved state, preceded by its size
+  Serializer out;
+  out.openBuffer();
+  save(out);
+
+  uInt32 size = out.bufferSize();
+  memcpy(state, &size, sizeof(uInt32));
+  memcpy(state + sizeof(uInt32), out.buffer(), size);
+
+  return sizeof(uInt32) + size;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Device::restoreState(const uInt8* state)
+{
+  uInt32 size;
+  memcpy(&size, state, sizeof(uInt32));
+
+  Deserializer in;
+  in.openBuffer(state + sizeof(uInt32), size);
+  load(in);
+
+  return sizeof(uInt32) + size;
+}
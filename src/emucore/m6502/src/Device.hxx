@@ -88,6 +88,34 @@ class Device : public Serializable
     */
     virtual string name() const = 0;
 
+    /**
+      Answers the number of bytes used by cloneState().  This must be the
+      same for every state of the device.
+
+      @return The size of the state snapshot
+    */
+    virtual uInt32 stateSize() const;
+
+    /**
+      Copies the current state of this device to the given buffer, as a
+      raw snapshot which is only meant to be restored into this same
+      device.  By default this is whatever save() writes, but devices
+      whose state is cloned often should copy it directly instead.
+
+      @param state  The buffer of stateSize() bytes to copy the state to
+      @return  The number of bytes copied (always stateSize())
+    */
+    virtual uInt32 cloneState(uInt8* state) const;
+
+    /**
+      Restores the state of this device from a snapshot which was taken
+      by cloneState().
+
+      @param state  The buffer to restore the state from
+      @return  The number of bytes used from the buffer
+    */
+    virtual uInt32 restoreState(const uInt8* state);
+
   public:
     /**
       Get the byte at the specified address
@@ -16,6 +16,8 @@
 // $Id$
 //============================================================================
 
+#include <cstring>
+
 #include "M6502.hxx"
 
 #ifdef DEBUGGER_SUPPORT
@@ -35,6 +37,7 @@ M6502::M6502(uInt32 systemCyclesPerProcessorCycle)
   myBreakPoints = NULL;
   myReadTraps   = NULL;
   myWriteTraps  = NULL;
+  myJustHitTrapFlag = false;
 #endif
 
   // Compute the System Cycle table
@@ -93,6 +96,47 @@ void M6502::nmi()
   myExecutionStatus |= NonmaskableInterruptBit;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The processor state copied by cloneState()
+struct M6502State
+{
+  uInt8 A, X, Y, SP, IR;
+  uInt16 PC;
+  bool N, V, B, D, I, notZ, C;
+  uInt8 executionStatus;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 M6502::stateSize() const
+{
+  return sizeof(M6502State);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 M6502::cloneState(uInt8* state) const
+{
+  M6502State s;
+  memset(&s, 0, sizeof(s));
+  s.A = A;  s.X = X;  s.Y = Y;  s.SP = SP;  s.IR = IR;  s.PC = PC;
+  s.N = N;  s.V = V;  s.B = B;  s.D = D;  s.I = I;  s.notZ = notZ;  s.C = C;
+  s.executionStatus = myExecutionStatus;
+  memcpy(state, &s, sizeof(s));
+
+  return sizeof(s);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 M6502::restoreState(const uInt8* state)
+{
+  M6502State s;
+  memcpy(&s, state, sizeof(s));
+  A = s.A;  X = s.X;  Y = s.Y;  SP = s.SP;  IR = s.IR;  PC = s.PC;
+  N = s.N;  V = s.V;  B = s.B;  D = s.D;  I = s.I;  notZ = s.notZ;  C = s.C;
+  myExecutionStatus = s.executionStatus;
+
+  return sizeof(s);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::stop()
 {
@@ -183,7 +227,7 @@ ostream& operator<<(ostream& out, const M6502::AddressingMode& mode)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-M6502::AddressingMode M6502::ourAddressingModeTable[256] = {
+const M6502::AddressingMode M6502::ourAddressingModeTable[256] = {
   Implied,    IndirectX, Invalid,   IndirectX,    // 0x0?
   Zero,       Zero,      Zero,      Zero,
   Implied,    Immediate, Implied,   Immediate,
@@ -266,7 +310,7 @@ M6502::AddressingMode M6502::ourAddressingModeTable[256] = {
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-M6502::AccessMode M6502::ourAccessModeTable[256] = {
+const M6502::AccessMode M6502::ourAccessModeTable[256] = {
   None,   Read,   None,   Write,    // 0x0?
   None,   Read,   Write,  Write,
   None,   Read,   Write,  Read,
@@ -349,7 +393,7 @@ M6502::AccessMode M6502::ourAccessModeTable[256] = {
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 M6502::ourInstructionProcessorCycleTable[256] = {
+const uInt32 M6502::ourInstructionProcessorCycleTable[256] = {
 //  0  1  2  3  4  5  6  7  8  9  a  b  c  d  e  f
     7, 6, 2, 8, 3, 3, 5, 5, 3, 2, 2, 2, 4, 4, 6, 6,  // 0
     2, 5, 2, 8, 4, 4, 6, 6, 2, 4, 2, 7, 4, 4, 7, 7,  // 1
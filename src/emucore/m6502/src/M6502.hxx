@@ -133,6 +133,32 @@ class M6502
     */
     virtual const char* name() const = 0;
 
+    /**
+      Answers the number of bytes used by cloneState().
+
+      @return The size of the state snapshot
+    */
+    virtual uInt32 stateSize() const;
+
+    /**
+      Copies the current state of this processor to the given buffer, as
+      a raw snapshot which is much faster to take than save(), but which
+      is only meant to be restored into this same processor.
+
+      @param state The buffer of stateSize() bytes to copy the state to
+      @return The number of bytes copied (always stateSize())
+    */
+    virtual uInt32 cloneState(uInt8* state) const;
+
+    /**
+      Restores the state of this processor from a snapshot which was taken
+      by cloneState().
+
+      @param state The buffer to restore the state from
+      @return The number of bytes used from the buffer
+    */
+    virtual uInt32 restoreState(const uInt8* state);
+
   public:
     /**
       Get the addressing mode of the specified instruction
@@ -229,6 +255,19 @@ class M6502
     void clearCondBreaks();
     const StringList& getCondBreakNames() const;
     int evalCondBreaks();
+
+    /**
+      Answer true iff the debugger has installed any breakpoints, traps
+      or conditional breaks, which the core must then check for.
+
+      @return true iff the core must check for debugger events
+    */
+    bool debuggerHooksInstalled() const
+    {
+      return myBreakPoints != NULL || myReadTraps != NULL ||
+             myWriteTraps != NULL || !myBreakConds.isEmpty() ||
+             myJustHitTrapFlag;
+    }
 #endif
 
   protected:
@@ -318,17 +357,17 @@ class M6502
   protected:
     /// Addressing mode for each of the 256 opcodes
     /// This specifies how the opcode argument is addressed
-    static AddressingMode ourAddressingModeTable[256];
+    static const AddressingMode ourAddressingModeTable[256];
 
     /// Access mode for each of the 256 opcodes
     /// This specifies how the opcode will access its argument
-    static AccessMode ourAccessModeTable[256];
+    static const AccessMode ourAccessModeTable[256];
 
     /**
       Table of instruction processor cycle times.  In some cases additional 
       cycles will be added during the execution of an instruction.
     */
-    static uInt32 ourInstructionProcessorCycleTable[256];
+    static const uInt32 ourInstructionProcessorCycleTable[256];
 
     /// Table of instruction mnemonics
     static const char* ourInstructionMnemonicTable[256];
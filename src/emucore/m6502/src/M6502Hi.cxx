@@ -16,6 +16,8 @@
 // $Id$
 //============================================================================
 
+#include <cstring>
+
 #include "M6502Hi.hxx"
 #include "Serializer.hxx"
 #include "Deserializer.hxx"
@@ -26,6 +28,35 @@
 
 #define debugStream cout
 
+// Use direct-threaded dispatch (computed goto) for the instructions when
+// the compiler supports it, unless the switch statement is requested
+#if defined(__GNUC__) && !defined(M6502_SWITCH_DISPATCH)
+  #define M6502_THREADED_DISPATCH
+#endif
+
+#ifdef M6502_THREADED_DISPATCH
+  // Ends each instruction block in M6502HiThreaded.ins.  When nothing
+  // needs the attention of the execute loop, the next instruction is
+  // fetched and jumped to directly, so that each block has its own
+  // (better predicted) indirect branch.
+  #ifdef DEBUG
+    #define M6502_THREADED_NEXT goto M6502_OPCODE_DONE;
+  #else
+    #define M6502_THREADED_NEXT                 \
+      if(!Policy::checkDebugger &&              \
+         !myExecutionStatus && (number > 1))    \
+      {                                         \
+        myTotalInstructionCount++;              \
+        --number;                               \
+        operandAddress = 0;                     \
+        operand = 0;                            \
+        IR = fetch<Policy>(PC++);               \
+        goto *ourDispatchTable[IR];             \
+      }                                         \
+      goto M6502_OPCODE_DONE;
+  #endif
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 M6502High::M6502High(uInt32 systemCyclesPerProcessorCycle)
     : M6502(systemCyclesPerProcessorCycle)
@@ -33,6 +64,11 @@ M6502High::M6502High(uInt32 systemCyclesPerProcessorCycle)
   myNumberOfDistinctAccesses = 0;
   myLastAddress = 0;
 
+  myCodePage = 0xFFFF;
+  myCodeBase = 0;
+  myCodeGeneration = 0;
+  myPendingCycles = 0;
+
 #ifdef DEBUGGER_SUPPORT
   myJustHitTrapFlag = false;
 #endif
@@ -44,6 +80,7 @@ M6502High::~M6502High()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class Policy>
 inline uInt8 M6502High::peek(uInt16 address)
 {
   if(address != myLastAddress)
@@ -51,10 +88,13 @@ inline uInt8 M6502High::peek(uInt16 address)
     myNumberOfDistinctAccesses++;
     myLastAddress = address;
   }
-  mySystem->incrementCycles(mySystemCyclesPerProcessorCycle);
+
+  // The device may look at the cycle count, so bring it up to date first
+  mySystem->incrementCycles(myPendingCycles + mySystemCyclesPerProcessorCycle);
+  myPendingCycles = 0;
 
 #ifdef DEBUGGER_SUPPORT
-  if(myReadTraps != NULL && myReadTraps->isSet(address))
+  if(Policy::checkDebugger && myReadTraps != NULL && myReadTraps->isSet(address))
   {
     myJustHitTrapFlag = true;
     myHitTrapInfo.message = "RTrap: ";
@@ -68,6 +108,7 @@ inline uInt8 M6502High::peek(uInt16 address)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class Policy>
 inline void M6502High::poke(uInt16 address, uInt8 value)
 {
   if(address != myLastAddress)
@@ -75,10 +116,13 @@ inline void M6502High::poke(uInt16 address, uInt8 value)
     myNumberOfDistinctAccesses++;
     myLastAddress = address;
   }
-  mySystem->incrementCycles(mySystemCyclesPerProcessorCycle);
+
+  // The device may look at the cycle count, so bring it up to date first
+  mySystem->incrementCycles(myPendingCycles + mySystemCyclesPerProcessorCycle);
+  myPendingCycles = 0;
 
 #ifdef DEBUGGER_SUPPORT
-  if(myWriteTraps != NULL && myWriteTraps->isSet(address))
+  if(Policy::checkDebugger && myWriteTraps != NULL && myWriteTraps->isSet(address))
   {
     myJustHitTrapFlag = true;
     myHitTrapInfo.message = "WTrap: ";
@@ -90,12 +134,109 @@ inline void M6502High::poke(uInt16 address, uInt8 value)
   myLastAccessWasRead = false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class Policy>
+inline uInt8 M6502High::fetch(uInt16 address)
+{
+  // Read traps are only checked by peek()
+  if(Policy::checkDebugger)
+    return peek<Policy>(address);
+
+  // Look up the page again whenever it's a different one, or the system
+  // has changed its page access table (e.g. after a bankswitch)
+  uInt16 page = address >> mySystem->pageShift();
+  if(page != myCodePage ||
+     myCodeGeneration != mySystem->pageAccessGeneration())
+  {
+    myCodePage = page;
+    myCodeBase = mySystem->getPageAccess(
+        page & (mySystem->numberOfPages() - 1)).directPeekBase;
+    myCodeGeneration = mySystem->pageAccessGeneration();
+  }
+
+  // Pages handled by a device may have side effects when read
+  if(myCodeBase == 0)
+    return peek<Policy>(address);
+
+  if(address != myLastAddress)
+  {
+    myNumberOfDistinctAccesses++;
+    myLastAddress = address;
+  }
+
+  // Nothing can observe the cycle count during a direct read, so the
+  // cycle is only added to the system on the next peek() or poke(), or
+  // when execution stops
+  myPendingCycles += mySystemCyclesPerProcessorCycle;
+
+  uInt8 result = myCodeBase[address & mySystem->pageMask()];
+  mySystem->setDataBusState(result);
+  myLastAccessWasRead = true;
+  return result;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool M6502High::execute(uInt32 number)
 {
+#ifdef DEBUGGER_SUPPORT
+  // Only pay for the debugger checks when something is there to be checked
+  if(debuggerHooksInstalled())
+    return executeInstructions<DebugPolicy>(number);
+#endif
+
+  return executeInstructions<NormalPolicy>(number);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class Policy>
+bool M6502High::executeInstructions(uInt32 number)
+{
+#ifdef M6502_THREADED_DISPATCH
+  // Jump table for direct-threaded dispatch; the labels are defined by the
+  // instruction blocks in M6502HiThreaded.ins
+  static const void* const ourDispatchTable[256] = {
+    &&M6502_OPCODE_0x00, &&M6502_OPCODE_0x01, &&M6502_OPCODE_ILLEGAL, &&M6502_OPCODE_0x03, &&M6502_OPCODE_0x04, &&M6502_OPCODE_0x05, &&M6502_OPCODE_0x06, &&M6502_OPCODE_0x07,
+    &&M6502_OPCODE_0x08, &&M6502_OPCODE_0x09, &&M6502_OPCODE_0x0a, &&M6502_OPCODE_0x0b, &&M6502_OPCODE_0x0c, &&M6502_OPCODE_0x0d, &&M6502_OPCODE_0x0e, &&M6502_OPCODE_0x0f,
+    &&M6502_OPCODE_0x10, &&M6502_OPCODE_0x11, &&M6502_OPCODE_ILLEGAL, &&M6502_OPCODE_0x13, &&M6502_OPCODE_0x14, &&M6502_OPCODE_0x15, &&M6502_OPCODE_0x16, &&M6502_OPCODE_0x17,
+    &&M6502_OPCODE_0x18, &&M6502_OPCODE_0x19, &&M6502_OPCODE_0x1a, &&M6502_OPCODE_0x1b, &&M6502_OPCODE_0x1c, &&M6502_OPCODE_0x1d, &&M6502_OPCODE_0x1e, &&M6502_OPCODE_0x1f,
+    &&M6502_OPCODE_0x20, &&M6502_OPCODE_0x21, &&M6502_OPCODE_ILLEGAL, &&M6502_OPCODE_0x23, &&M6502_OPCODE_0x24, &&M6502_OPCODE_0x25, &&M6502_OPCODE_0x26, &&M6502_OPCODE_0x27,
+    &&M6502_OPCODE_0x28, &&M6502_OPCODE_0x29, &&M6502_OPCODE_0x2a, &&M6502_OPCODE_0x2b, &&M6502_OPCODE_0x2c, &&M6502_OPCODE_0x2d, &&M6502_OPCODE_0x2e, &&M6502_OPCODE_0x2f,
+    &&M6502_OPCODE_0x30, &&M6502_OPCODE_0x31, &&M6502_OPCODE_ILLEGAL, &&M6502_OPCODE_0x33, &&M6502_OPCODE_0x34, &&M6502_OPCODE_0x35, &&M6502_OPCODE_0x36, &&M6502_OPCODE_0x37,
+    &&M6502_OPCODE_0x38, &&M6502_OPCODE_0x39, &&M6502_OPCODE_0x3a, &&M6502_OPCODE_0x3b, &&M6502_OPCODE_0x3c, &&M6502_OPCODE_0x3d, &&M6502_OPCODE_0x3e, &&M6502_OPCODE_0x3f,
+    &&M6502_OPCODE_0x40, &&M6502_OPCODE_0x41, &&M6502_OPCODE_ILLEGAL, &&M6502_OPCODE_0x43, &&M6502_OPCODE_0x44, &&M6502_OPCODE_0x45, &&M6502_OPCODE_0x46, &&M6502_OPCODE_0x47,
+    &&M6502_OPCODE_0x48, &&M6502_OPCODE_0x49, &&M6502_OPCODE_0x4a, &&M6502_OPCODE_0x4b, &&M6502_OPCODE_0x4c, &&M6502_OPCODE_0x4d, &&M6502_OPCODE_0x4e, &&M6502_OPCODE_0x4f,
+    &&M6502_OPCODE_0x50, &&M6502_OPCODE_0x51, &&M6502_OPCODE_ILLEGAL, &&M6502_OPCODE_0x53, &&M6502_OPCODE_0x54, &&M6502_OPCODE_0x55, &&M6502_OPCODE_0x56, &&M6502_OPCODE_0x57,
+    &&M6502_OPCODE_0x58, &&M6502_OPCODE_0x59, &&M6502_OPCODE_0x5a, &&M6502_OPCODE_0x5b, &&M6502_OPCODE_0x5c, &&M6502_OPCODE_0x5d, &&M6502_OPCODE_0x5e, &&M6502_OPCODE_0x5f,
+    &&M6502_OPCODE_0x60, &&M6502_OPCODE_0x61, &&M6502_OPCODE_ILLEGAL, &&M6502_OPCODE_0x63, &&M6502_OPCODE_0x64, &&M6502_OPCODE_0x65, &&M6502_OPCODE_0x66, &&M6502_OPCODE_0x67,
+    &&M6502_OPCODE_0x68, &&M6502_OPCODE_0x69, &&M6502_OPCODE_0x6a, &&M6502_OPCODE_0x6b, &&M6502_OPCODE_0x6c, &&M6502_OPCODE_0x6d, &&M6502_OPCODE_0x6e, &&M6502_OPCODE_0x6f,
+    &&M6502_OPCODE_0x70, &&M6502_OPCODE_0x71, &&M6502_OPCODE_ILLEGAL, &&M6502_OPCODE_0x73, &&M6502_OPCODE_0x74, &&M6502_OPCODE_0x75, &&M6502_OPCODE_0x76, &&M6502_OPCODE_0x77,
+    &&M6502_OPCODE_0x78, &&M6502_OPCODE_0x79, &&M6502_OPCODE_0x7a, &&M6502_OPCODE_0x7b, &&M6502_OPCODE_0x7c, &&M6502_OPCODE_0x7d, &&M6502_OPCODE_0x7e, &&M6502_OPCODE_0x7f,
+    &&M6502_OPCODE_0x80, &&M6502_OPCODE_0x81, &&M6502_OPCODE_0x82, &&M6502_OPCODE_0x83, &&M6502_OPCODE_0x84, &&M6502_OPCODE_0x85, &&M6502_OPCODE_0x86, &&M6502_OPCODE_0x87,
+    &&M6502_OPCODE_0x88, &&M6502_OPCODE_0x89, &&M6502_OPCODE_0x8a, &&M6502_OPCODE_0x8b, &&M6502_OPCODE_0x8c, &&M6502_OPCODE_0x8d, &&M6502_OPCODE_0x8e, &&M6502_OPCODE_0x8f,
+    &&M6502_OPCODE_0x90, &&M6502_OPCODE_0x91, &&M6502_OPCODE_ILLEGAL, &&M6502_OPCODE_0x93, &&M6502_OPCODE_0x94, &&M6502_OPCODE_0x95, &&M6502_OPCODE_0x96, &&M6502_OPCODE_0x97,
+    &&M6502_OPCODE_0x98, &&M6502_OPCODE_0x99, &&M6502_OPCODE_0x9a, &&M6502_OPCODE_0x9b, &&M6502_OPCODE_0x9c, &&M6502_OPCODE_0x9d, &&M6502_OPCODE_0x9e, &&M6502_OPCODE_0x9f,
+    &&M6502_OPCODE_0xa0, &&M6502_OPCODE_0xa1, &&M6502_OPCODE_0xa2, &&M6502_OPCODE_0xa3, &&M6502_OPCODE_0xa4, &&M6502_OPCODE_0xa5, &&M6502_OPCODE_0xa6, &&M6502_OPCODE_0xa7,
+    &&M6502_OPCODE_0xa8, &&M6502_OPCODE_0xa9, &&M6502_OPCODE_0xaa, &&M6502_OPCODE_0xab, &&M6502_OPCODE_0xac, &&M6502_OPCODE_0xad, &&M6502_OPCODE_0xae, &&M6502_OPCODE_0xaf,
+    &&M6502_OPCODE_0xb0, &&M6502_OPCODE_0xb1, &&M6502_OPCODE_ILLEGAL, &&M6502_OPCODE_0xb3, &&M6502_OPCODE_0xb4, &&M6502_OPCODE_0xb5, &&M6502_OPCODE_0xb6, &&M6502_OPCODE_0xb7,
+    &&M6502_OPCODE_0xb8, &&M6502_OPCODE_0xb9, &&M6502_OPCODE_0xba, &&M6502_OPCODE_0xbb, &&M6502_OPCODE_0xbc, &&M6502_OPCODE_0xbd, &&M6502_OPCODE_0xbe, &&M6502_OPCODE_0xbf,
+    &&M6502_OPCODE_0xc0, &&M6502_OPCODE_0xc1, &&M6502_OPCODE_0xc2, &&M6502_OPCODE_0xc3, &&M6502_OPCODE_0xc4, &&M6502_OPCODE_0xc5, &&M6502_OPCODE_0xc6, &&M6502_OPCODE_0xc7,
+    &&M6502_OPCODE_0xc8, &&M6502_OPCODE_0xc9, &&M6502_OPCODE_0xca, &&M6502_OPCODE_0xcb, &&M6502_OPCODE_0xcc, &&M6502_OPCODE_0xcd, &&M6502_OPCODE_0xce, &&M6502_OPCODE_0xcf,
+    &&M6502_OPCODE_0xd0, &&M6502_OPCODE_0xd1, &&M6502_OPCODE_ILLEGAL, &&M6502_OPCODE_0xd3, &&M6502_OPCODE_0xd4, &&M6502_OPCODE_0xd5, &&M6502_OPCODE_0xd6, &&M6502_OPCODE_0xd7,
+    &&M6502_OPCODE_0xd8, &&M6502_OPCODE_0xd9, &&M6502_OPCODE_0xda, &&M6502_OPCODE_0xdb, &&M6502_OPCODE_0xdc, &&M6502_OPCODE_0xdd, &&M6502_OPCODE_0xde, &&M6502_OPCODE_0xdf,
+    &&M6502_OPCODE_0xe0, &&M6502_OPCODE_0xe1, &&M6502_OPCODE_0xe2, &&M6502_OPCODE_0xe3, &&M6502_OPCODE_0xe4, &&M6502_OPCODE_0xe5, &&M6502_OPCODE_0xe6, &&M6502_OPCODE_0xe7,
+    &&M6502_OPCODE_0xe8, &&M6502_OPCODE_0xe9, &&M6502_OPCODE_0xea, &&M6502_OPCODE_0xeb, &&M6502_OPCODE_0xec, &&M6502_OPCODE_0xed, &&M6502_OPCODE_0xee, &&M6502_OPCODE_0xef,
+    &&M6502_OPCODE_0xf0, &&M6502_OPCODE_0xf1, &&M6502_OPCODE_ILLEGAL, &&M6502_OPCODE_0xf3, &&M6502_OPCODE_0xf4, &&M6502_OPCODE_0xf5, &&M6502_OPCODE_0xf6, &&M6502_OPCODE_0xf7,
+    &&M6502_OPCODE_0xf8, &&M6502_OPCODE_0xf9, &&M6502_OPCODE_0xfa, &&M6502_OPCODE_0xfb, &&M6502_OPCODE_0xfc, &&M6502_OPCODE_0xfd, &&M6502_OPCODE_0xfe, &&M6502_OPCODE_0xff
+  };
+#endif
+
   // Clear all of the execution status bits except for the fatal error bit
   myExecutionStatus &= FatalErrorBit;
 
+  // The processor may have been installed in another system or had its
+  // state loaded since the last call, so don't trust the code cache
+  myCodePage = 0xFFFF;
+
   // Loop until execution is stopped or a fatal error occurs
   for(;;)
   {
@@ -105,30 +246,33 @@ bool M6502High::execute(uInt32 number)
       uInt8 operand = 0;
 
 #ifdef DEBUGGER_SUPPORT
-      if(myJustHitTrapFlag)
+      if(Policy::checkDebugger)
       {
-        if(myDebugger->start(myHitTrapInfo.message, myHitTrapInfo.address))
+        if(myJustHitTrapFlag)
         {
-          myJustHitTrapFlag = false;
-          return true;
+          if(myDebugger->start(myHitTrapInfo.message, myHitTrapInfo.address))
+          {
+            myJustHitTrapFlag = false;
+            return true;
+          }
         }
-      }
 
-      if(myBreakPoints != NULL)
-      {
-        if(myBreakPoints->isSet(PC))
+        if(myBreakPoints != NULL)
         {
-          if(myDebugger->start("BP: ", PC))
-            return true;
+          if(myBreakPoints->isSet(PC))
+          {
+            if(myDebugger->start("BP: ", PC))
+              return true;
+          }
         }
-      }
 
-      int cond = evalCondBreaks();
-      if(cond > -1)
-      {
-        string buf = "CBP: " + myBreakCondNames[cond];
-        if(myDebugger->start(buf))
-          return true;
+        int cond = evalCondBreaks();
+        if(cond > -1)
+        {
+          string buf = "CBP: " + myBreakCondNames[cond];
+          if(myDebugger->start(buf))
+            return true;
+        }
       }
 #endif
 
@@ -137,14 +281,32 @@ bool M6502High::execute(uInt32 number)
 #endif
 
       // Fetch instruction at the program counter
-      IR = peek(PC++);
+      IR = fetch<Policy>(PC++);
 
 #ifdef DEBUG
       debugStream << "IR=" << hex << setw(2) << (int)IR << " ";
       debugStream << "<" << ourAddressingModeTable[IR] << " ";
 #endif
 
+      // The instruction code generated by M4 calls peek(), poke() and
+      // fetch(), which must use the same policy as this method
+      #define peek(address) peek<Policy>(address)
+      #define poke(address, value) poke<Policy>(address, value)
+      #define fetch(address) fetch<Policy>(address)
+
       // Call code to execute the instruction
+#ifdef M6502_THREADED_DISPATCH
+      goto *ourDispatchTable[IR];
+
+      // 6502 instruction emulation is generated by an M4 macro file
+      #include "M6502HiThreaded.ins"
+
+    M6502_OPCODE_ILLEGAL:
+      // Oops, illegal instruction executed so set fatal error flag
+      myExecutionStatus |= FatalErrorBit;
+
+    M6502_OPCODE_DONE:
+#else
       switch(IR)
       {
         // 6502 instruction emulation is generated by an M4 macro file
@@ -154,6 +316,11 @@ bool M6502High::execute(uInt32 number)
           // Oops, illegal instruction executed so set fatal error flag
           myExecutionStatus |= FatalErrorBit;
       }
+#endif
+
+      #undef peek
+      #undef poke
+      #undef fetch
 
       myTotalInstructionCount++;
 
@@ -171,6 +338,10 @@ bool M6502High::execute(uInt32 number)
 #endif
     }
 
+    // Add the cycles of any direct reads which haven't been accounted for
+    mySystem->incrementCycles(myPendingCycles);
+    myPendingCycles = 0;
+
     // See if we need to handle an interrupt
     if((myExecutionStatus & MaskableInterruptBit) || 
         (myExecutionStatus & NonmaskableInterruptBit))
@@ -322,6 +493,34 @@ bool M6502High::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 M6502High::stateSize() const
+{
+  return M6502::stateSize() + sizeof(uInt32) + sizeof(uInt16);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 M6502High::cloneState(uInt8* state) const
+{
+  uInt32 size = M6502::cloneState(state);
+  memcpy(state + size, &myNumberOfDistinctAccesses, sizeof(uInt32));
+  size += sizeof(uInt32);
+  memcpy(state + size, &myLastAddress, sizeof(uInt16));
+
+  return size + sizeof(uInt16);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 M6502High::restoreState(const uInt8* state)
+{
+  uInt32 size = M6502::restoreState(state);
+  memcpy(&myNumberOfDistinctAccesses, state + size, sizeof(uInt32));
+  size += sizeof(uInt32);
+  memcpy(&myLastAddress, state + size, sizeof(uInt16));
+
+  return size + sizeof(uInt16);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const char* M6502High::name() const
 {
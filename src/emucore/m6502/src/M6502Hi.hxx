@@ -87,6 +87,30 @@ class M6502High : public M6502
     */
     virtual const char* name() const;
 
+    /**
+      Answers the number of bytes used by cloneState().
+
+      @return The size of the state snapshot
+    */
+    virtual uInt32 stateSize() const;
+
+    /**
+      Copies the current state of this processor to the given buffer.
+
+      @param state The buffer of stateSize() bytes to copy the state to
+      @return The number of bytes copied (always stateSize())
+    */
+    virtual uInt32 cloneState(uInt8* state) const;
+
+    /**
+      Restores the state of this processor from a snapshot which was taken
+      by cloneState().
+
+      @param state The buffer to restore the state from
+      @return The number of bytes used from the buffer
+    */
+    virtual uInt32 restoreState(const uInt8* state);
+
   public:
     /**
       Get the number of memory accesses to distinct memory locations
@@ -105,13 +129,31 @@ class M6502High : public M6502
     void interruptHandler();
 
   protected:
+    /**
+      Policies for executeInstructions(), peek() and poke().  Only the
+      debug policy checks for breakpoints, traps and conditional breaks,
+      so that the normal policy runs at full speed even when the debugger
+      is compiled in.
+    */
+    struct NormalPolicy { enum { checkDebugger = 0 }; };
+    struct DebugPolicy  { enum { checkDebugger = 1 }; };
+
+    /**
+      Execute instructions using the given policy; see execute() for
+      the meaning of the parameter and the return value.
+
+      @param number Indicates the number of instructions to execute
+      @return true iff execution stops normally
+    */
+    template<class Policy> bool executeInstructions(uInt32 number);
+
     /*
       Get the byte at the specified address and update the cycle
       count
 
       @return The byte at the specified address
     */
-    inline uInt8 peek(uInt16 address);
+    template<class Policy> inline uInt8 peek(uInt16 address);
 
     /**
       Change the byte at the specified address to the given value and
@@ -120,7 +162,18 @@ class M6502High : public M6502
       @param address The address where the value should be stored
       @param value The value to be stored at the address
     */
-    inline void poke(uInt16 address, uInt8 value);
+    template<class Policy> inline void poke(uInt16 address, uInt8 value);
+
+    /**
+      Get the byte of the instruction stream at the specified address
+      and update the cycle count.  This behaves like peek(), but reads
+      directly accessible code pages through a cached pointer instead of
+      going through the system, and leaves the cycles of such reads
+      pending until something is able to observe them.
+
+      @return The byte at the specified address
+    */
+    template<class Policy> inline uInt8 fetch(uInt16 address);
 
   private:
     // Indicates the numer of distinct memory accesses
@@ -128,6 +181,17 @@ class M6502High : public M6502
 
     // Indicates the last address which was accessed
     uInt16 myLastAddress;
+
+    // The page of the most recent fetch, its direct peek base (or 0 if the
+    // page is handled by a device), and the system's page access generation
+    // when they were looked up
+    uInt16 myCodePage;
+    const uInt8* myCodeBase;
+    uInt32 myCodeGeneration;
+
+    // System cycles used by fetch() which haven't been added to the system
+    // yet; they're added before the next access to a device
+    uInt32 myPendingCycles;
 };
 #endif
 
@@ -18,7 +18,9 @@
 
 /**
   Code to handle addressing modes and branch instructions for
-  high compatibility emulation
+  high compatibility emulation.  Bytes of the instruction stream are
+  read with fetch() rather than peek(), so they can come from the
+  processor's code cache.
 
   @author  Bradford W. Mott
   @version $Id$
@@ -29,49 +31,49 @@
 #endif
 
 define(M6502_IMPLIED, `{
-  peek(PC);
+  fetch(PC);
 }')
 
 define(M6502_IMMEDIATE_READ, `{
-  operand = peek(PC++);
+  operand = fetch(PC++);
 }')
 
 define(M6502_ABSOLUTE_READ, `{
-  uInt16 address = peek(PC++);
-  address |= ((uInt16)peek(PC++) << 8);
+  uInt16 address = fetch(PC++);
+  address |= ((uInt16)fetch(PC++) << 8);
   operand = peek(address);
 }')
 
 define(M6502_ABSOLUTE_WRITE, `{
-  operandAddress = peek(PC++);
-  operandAddress |= ((uInt16)peek(PC++) << 8);
+  operandAddress = fetch(PC++);
+  operandAddress |= ((uInt16)fetch(PC++) << 8);
 }')
 
 define(M6502_ABSOLUTE_READMODIFYWRITE, `{
-  operandAddress = peek(PC++);
-  operandAddress |= ((uInt16)peek(PC++) << 8);
+  operandAddress = fetch(PC++);
+  operandAddress |= ((uInt16)fetch(PC++) << 8);
   operand = peek(operandAddress);
   poke(operandAddress, operand);
 }')
 
 define(M6502_ABSOLUTEX_READ, `{
-  uInt16 low = peek(PC++);
-  uInt16 high = ((uInt16)peek(PC++) << 8);
+  uInt16 low = fetch(PC++);
+  uInt16 high = ((uInt16)fetch(PC++) << 8);
   operand = peek(high | (uInt8)(low + X));
   if((low + X) > 0xFF)
     operand = peek((high | low) + X);
 }')
 
 define(M6502_ABSOLUTEX_WRITE, `{
-  uInt16 low = peek(PC++);
-  uInt16 high = ((uInt16)peek(PC++) << 8);
+  uInt16 low = fetch(PC++);
+  uInt16 high = ((uInt16)fetch(PC++) << 8);
   peek(high | (uInt8)(low + X));
   operandAddress = (high | low) + X;
 }')
 
 define(M6502_ABSOLUTEX_READMODIFYWRITE, `{
-  uInt16 low = peek(PC++);
-  uInt16 high = ((uInt16)peek(PC++) << 8);
+  uInt16 low = fetch(PC++);
+  uInt16 high = ((uInt16)fetch(PC++) << 8);
   peek(high | (uInt8)(low + X));
   operandAddress = (high | low) + X;
   operand = peek(operandAddress);
@@ -79,23 +81,23 @@ define(M6502_ABSOLUTEX_READMODIFYWRITE, `{
 }')
 
 define(M6502_ABSOLUTEY_READ, `{
-  uInt16 low = peek(PC++);
-  uInt16 high = ((uInt16)peek(PC++) << 8);
+  uInt16 low = fetch(PC++);
+  uInt16 high = ((uInt16)fetch(PC++) << 8);
   operand = peek(high | (uInt8)(low + Y));
   if((low + Y) > 0xFF)
     operand = peek((high | low) + Y);
 }')
 
 define(M6502_ABSOLUTEY_WRITE, `{
-  uInt16 low = peek(PC++);
-  uInt16 high = ((uInt16)peek(PC++) << 8);
+  uInt16 low = fetch(PC++);
+  uInt16 high = ((uInt16)fetch(PC++) << 8);
   peek(high | (uInt8)(low + Y));
   operandAddress = (high | low) + Y;
 }')
 
 define(M6502_ABSOLUTEY_READMODIFYWRITE, `{
-  uInt16 low = peek(PC++);
-  uInt16 high = ((uInt16)peek(PC++) << 8);
+  uInt16 low = fetch(PC++);
+  uInt16 high = ((uInt16)fetch(PC++) << 8);
   peek(high | (uInt8)(low + Y));
   operandAddress = (high | low) + Y;
   operand = peek(operandAddress);
@@ -103,34 +105,34 @@ define(M6502_ABSOLUTEY_READMODIFYWRITE, `{
 }')
 
 define(M6502_ZERO_READ, `{
-  operand = peek(peek(PC++));
+  operand = peek(fetch(PC++));
 }')
 
 define(M6502_ZERO_WRITE, `{
-  operandAddress = peek(PC++);
+  operandAddress = fetch(PC++);
 }')
 
 define(M6502_ZERO_READMODIFYWRITE, `{
-  operandAddress = peek(PC++);
+  operandAddress = fetch(PC++);
   operand = peek(operandAddress);
   poke(operandAddress, operand);
 }')
 
 define(M6502_ZEROX_READ, `{
-  uInt8 address = peek(PC++);
+  uInt8 address = fetch(PC++);
   peek(address);
   address += X;
   operand = peek(address); 
 }')
 
 define(M6502_ZEROX_WRITE, `{
-  operandAddress = peek(PC++);
+  operandAddress = fetch(PC++);
   peek(operandAddress);
   operandAddress = (operandAddress + X) & 0xFF;
 }')
 
 define(M6502_ZEROX_READMODIFYWRITE, `{
-  operandAddress = peek(PC++);
+  operandAddress = fetch(PC++);
   peek(operandAddress);
   operandAddress = (operandAddress + X) & 0xFF;
   operand = peek(operandAddress);
@@ -138,20 +140,20 @@ define(M6502_ZEROX_READMODIFYWRITE, `{
 }')
 
 define(M6502_ZEROY_READ, `{
-  uInt8 address = peek(PC++);
+  uInt8 address = fetch(PC++);
   peek(address);
   address += Y;
   operand = peek(address); 
 }')
 
 define(M6502_ZEROY_WRITE, `{
-  operandAddress = peek(PC++);
+  operandAddress = fetch(PC++);
   peek(operandAddress);
   operandAddress = (operandAddress + Y) & 0xFF;
 }')
 
 define(M6502_ZEROY_READMODIFYWRITE, `{
-  operandAddress = peek(PC++);
+  operandAddress = fetch(PC++);
   peek(operandAddress);
   operandAddress = (operandAddress + Y) & 0xFF;
   operand = peek(operandAddress);
@@ -159,8 +161,8 @@ define(M6502_ZEROY_READMODIFYWRITE, `{
 }')
 
 define(M6502_INDIRECT, `{
-  uInt16 addr = peek(PC++);
-  addr |= ((uInt16)peek(PC++) << 8);
+  uInt16 addr = fetch(PC++);
+  addr |= ((uInt16)fetch(PC++) << 8);
 
   // Simulate the error in the indirect addressing mode!
   uInt16 high = NOTSAMEPAGE(addr, addr + 1) ? (addr & 0xff00) : (addr + 1);
@@ -170,7 +172,7 @@ define(M6502_INDIRECT, `{
 }')
 
 define(M6502_INDIRECTX_READ, `{
-  uInt8 pointer = peek(PC++);
+  uInt8 pointer = fetch(PC++);
   peek(pointer);
   pointer += X;
   uInt16 address = peek(pointer++);
@@ -179,7 +181,7 @@ define(M6502_INDIRECTX_READ, `{
 }')
 
 define(M6502_INDIRECTX_WRITE, `{
-  uInt8 pointer = peek(PC++);
+  uInt8 pointer = fetch(PC++);
   peek(pointer);
   pointer += X;
   operandAddress = peek(pointer++);
@@ -187,7 +189,7 @@ define(M6502_INDIRECTX_WRITE, `{
 }')
 
 define(M6502_INDIRECTX_READMODIFYWRITE, `{
-  uInt8 pointer = peek(PC++);
+  uInt8 pointer = fetch(PC++);
   peek(pointer);
   pointer += X;
   operandAddress = peek(pointer++);
@@ -197,7 +199,7 @@ define(M6502_INDIRECTX_READMODIFYWRITE, `{
 }')
 
 define(M6502_INDIRECTY_READ, `{
-  uInt8 pointer = peek(PC++);
+  uInt8 pointer = fetch(PC++);
   uInt16 low = peek(pointer++);
   uInt16 high = ((uInt16)peek(pointer) << 8);
   operand = peek(high | (uInt8)(low + Y));
@@ -206,7 +208,7 @@ define(M6502_INDIRECTY_READ, `{
 }')
 
 define(M6502_INDIRECTY_WRITE, `{
-  uInt8 pointer = peek(PC++);
+  uInt8 pointer = fetch(PC++);
   uInt16 low = peek(pointer++);
   uInt16 high = ((uInt16)peek(pointer) << 8);
   peek(high | (uInt8)(low + Y));
@@ -214,7 +216,7 @@ define(M6502_INDIRECTY_WRITE, `{
 }')
 
 define(M6502_INDIRECTY_READMODIFYWRITE, `{
-  uInt8 pointer = peek(PC++);
+  uInt8 pointer = fetch(PC++);
   uInt16 low = peek(pointer++);
   uInt16 high = ((uInt16)peek(pointer) << 8);
   peek(high | (uInt8)(low + Y));
@@ -227,7 +229,7 @@ define(M6502_INDIRECTY_READMODIFYWRITE, `{
 define(M6502_BCC, `{
   if(!C)
   {
-    peek(PC);
+    fetch(PC);
     uInt16 address = PC + (Int8)operand;
     if(NOTSAMEPAGE(PC, address))
       peek((PC & 0xFF00) | (address & 0x00FF));
@@ -238,7 +240,7 @@ define(M6502_BCC, `{
 define(M6502_BCS, `{
   if(C)
   {
-    peek(PC);
+    fetch(PC);
     uInt16 address = PC + (Int8)operand;
     if(NOTSAMEPAGE(PC, address))
       peek((PC & 0xFF00) | (address & 0x00FF));
@@ -249,7 +251,7 @@ define(M6502_BCS, `{
 define(M6502_BEQ, `{
   if(!notZ)
   {
-    peek(PC);
+    fetch(PC);
     uInt16 address = PC + (Int8)operand;
     if(NOTSAMEPAGE(PC, address))
       peek((PC & 0xFF00) | (address & 0x00FF));
@@ -260,7 +262,7 @@ define(M6502_BEQ, `{
 define(M6502_BMI, `{
   if(N)
   {
-    peek(PC);
+    fetch(PC);
     uInt16 address = PC + (Int8)operand;
     if(NOTSAMEPAGE(PC, address))
       peek((PC & 0xFF00) | (address & 0x00FF));
@@ -271,7 +273,7 @@ define(M6502_BMI, `{
 define(M6502_BNE, `{
   if(notZ)
   {
-    peek(PC);
+    fetch(PC);
     uInt16 address = PC + (Int8)operand;
     if(NOTSAMEPAGE(PC, address))
       peek((PC & 0xFF00) | (address & 0x00FF));
@@ -282,7 +284,7 @@ define(M6502_BNE, `{
 define(M6502_BPL, `{
   if(!N)
   {
-    peek(PC);
+    fetch(PC);
     uInt16 address = PC + (Int8)operand;
     if(NOTSAMEPAGE(PC, address))
       peek((PC & 0xFF00) | (address & 0x00FF));
@@ -293,7 +295,7 @@ define(M6502_BPL, `{
 define(M6502_BVC, `{
   if(!V)
   {
-    peek(PC);
+    fetch(PC);
     uInt16 address = PC + (Int8)operand;
     if(NOTSAMEPAGE(PC, address))
       peek((PC & 0xFF00) | (address & 0x00FF));
@@ -304,7 +306,7 @@ define(M6502_BVC, `{
 define(M6502_BVS, `{
   if(V)
   {
-    peek(PC);
+    fetch(PC);
     uInt16 address = PC + (Int8)operand;
     if(NOTSAMEPAGE(PC, address))
       peek((PC & 0xFF00) | (address & 0x00FF));
@@ -0,0 +1,33 @@
+//============================================================================
+//
+// MM     MM  6666  555555  0000   2222
+// MMMM MMMM 66  66 55     00  00 22  22
+// MM MMM MM 66     55     00  00     22
+// MM  M  MM 66666  55555  00  00  22222  --  "A 6502 Microprocessor Emulator"
+// MM     MM 66  66     55 00  00 22
+// MM     MM 66  66 55  55 00  00 22
+// MM     MM  6666   5555   0000  222222
+//
+// Copyright (c) 1995-2005 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+/**
+  Turns each instruction into a labelled block for direct-threaded
+  dispatch (computed goto), instead of a case in a switch statement.
+  Each block ends with M6502_THREADED_NEXT, which must be defined by
+  the including core.
+
+  Recompile with the following:
+    'm4 M6502Hi.m4 M6502Threaded.m4 M6502.m4 > M6502HiThreaded.ins'
+
+  @author  Bradford W. Mott
+  @version $Id$
+*/
+
+define(M6502_CASE, `M6502_OPCODE_$1:')
+define(M6502_BREAK, `M6502_THREADED_NEXT')
@@ -17,6 +17,7 @@
 //============================================================================
 
 #include <assert.h>
+#include <cstring>
 #include <iostream>
 
 #include "Device.hxx"
@@ -31,6 +32,7 @@ System::System(uInt16 n, uInt16 m)
     myPageShift(m),
     myPageMask((1 << m) - 1),
     myNumberOfPages(1 << (n - m)),
+    myPageAccessGeneration(0),
     myNumberOfDevices(0),
     myM6502(0),
     myTIA(0),
@@ -39,7 +41,7 @@ System::System(uInt16 n, uInt16 m)
     myDataBusLocked(false)
 {
   // Make sure the arguments are reasonable
-  assert((1 <= m) && (m <= n) && (n <= 16));
+  assert((m <= n) && (1 <= n) && (n <= 16));
 
   // Allocate page table
   myPageAccessTable = new PageAccess[myNumberOfPages];
@@ -155,6 +157,18 @@ void System::setPageAccess(uInt16 page, const PageAccess& access)
   assert(access.device != 0);
 
   myPageAccessTable[page] = access;
+  ++myPageAccessGeneration;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void System::setPageAccess(uInt16 page, uInt16 count, const PageAccess* access)
+{
+  // Make sure the pages are within range
+  assert(page + count <= myNumberOfPages);
+
+  for(uInt16 i = 0; i < count; ++i)
+    myPageAccessTable[page + i] = access[i];
+  ++myPageAccessGeneration;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -166,6 +180,45 @@ const System::PageAccess& System::getPageAccess(uInt16 page)
   return myPageAccessTable[page];
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 System::stateSize() const
+{
+  uInt32 size = sizeof(myCycles) + sizeof(myDataBusState) +
+                myM6502->stateSize();
+  for(uInt32 i = 0; i < myNumberOfDevices; ++i)
+    size += myDevices[i]->stateSize();
+
+  return size;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 System::cloneState(uInt8* state) const
+{
+  uInt32 size = sizeof(myCycles);
+  memcpy(state, &myCycles, size);
+  state[size++] = myDataBusState;
+
+  size += myM6502->cloneState(state + size);
+  for(uInt32 i = 0; i < myNumberOfDevices; ++i)
+    size += myDevices[i]->cloneState(state + size);
+
+  return size;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 System::restoreState(const uInt8* state)
+{
+  uInt32 size = sizeof(myCycles);
+  memcpy(&myCycles, state, size);
+  myDataBusState = state[size++];
+
+  size += myM6502->restoreState(state + size);
+  for(uInt32 i = 0; i < myNumberOfDevices; ++i)
+    size += myDevices[i]->restoreState(state + size);
+
+  return size;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 System::System(const System& s)
   : myAddressMask(s.myAddressMask),
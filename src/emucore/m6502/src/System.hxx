@@ -28,14 +28,18 @@ class NullDevice;
 #include "bspf.hxx"
 #include "Device.hxx"
 #include "NullDev.hxx"
+#include "Random.hxx"
 #include "Serializable.hxx"
 
 /**
   This class represents a system consisting of a 6502 microprocessor
   and a set of devices.  The devices are mapped into an addressing
   space of 2^n bytes (1 <= n <= 16).  The addressing space is broken
-  into 2^m byte pages (1 <= m <= n), where a page is the smallest unit
-  a device can use when installing itself in the system.
+  into 2^m byte pages (0 <= m <= n), where a page is the smallest unit
+  a device can use when installing itself in the system.  With m = 0
+  every address is decoded on its own, so a device which only needs a
+  few hotspot addresses doesn't take the rest of their page away from
+  direct access, at the cost of more work when pages are remapped.
 
   In general the addressing space will be 8192 (2^13) bytes for a 
   6507 based system and 65536 (2^16) bytes for a 6502 based system.
@@ -54,7 +58,7 @@ class System : public Serializable
   public:
     /**
       Create a new system with an addressing space of 2^n bytes and
-      pages of 2^m bytes.
+      pages of 2^m bytes (use m = 0 for per-address decoding).
 
       @param n Log base 2 of the addressing space size
       @param m Log base 2 of the page size
@@ -150,6 +154,18 @@ class System : public Serializable
       return myNullDevice;
     }
 
+    /**
+      Get the random number generator associated with the system.
+      Devices use it to randomize their memory on reset; it's seeded
+      by whoever creates the system (see Console).
+
+      @return The random number generator associated with the system
+    */
+    Random& randGenerator()
+    {
+      return myRandom;
+    }
+
     /**
       Get the total number of pages available in the system.
 
@@ -210,6 +226,18 @@ class System : public Serializable
     */
     void resetCycles();
 
+    /**
+      Get a number which changes whenever the page access table changes
+      (for instance, when a cartridge switches banks).  Results of
+      getPageAccess() may be cached for as long as this stays the same.
+
+      @return The current generation of the page access table
+    */
+    uInt32 pageAccessGeneration() const
+    {
+      return myPageAccessGeneration;
+    }
+
   public:
     /**
       Get the current state of the data bus in the system.  The current
@@ -241,6 +269,20 @@ class System : public Serializable
     */
     void poke(uInt16 address, uInt8 value);
 
+    /**
+      Update the state of the data bus after a read which bypassed peek(),
+      such as the processor reading code through its code cache.
+
+      @param value The value which was read
+    */
+    void setDataBusState(uInt8 value)
+    {
+#ifdef DEBUGGER_SUPPORT
+      if(!myDataBusLocked)
+#endif
+        myDataBusState = value;
+    }
+
     /**
       Lock/unlock the data bus. When the bus is locked, peek() and
       poke() don't update the bus state. The bus should be unlocked
@@ -290,6 +332,18 @@ class System : public Serializable
     */
     void setPageAccess(uInt16 page, const PageAccess& access);
 
+    /**
+      Set the page accessing methods for a run of consecutive pages.
+      This is much cheaper than setting the pages one at a time, and is
+      meant for devices which precompute their page accesses (such as
+      cartridges switching between banks).
+
+      @param page The first page accessing methods should be set for
+      @param count The number of pages to set
+      @param access The accessing methods to be used by each of the pages
+    */
+    void setPageAccess(uInt16 page, uInt16 count, const PageAccess* access);
+
     /**
       Get the page accessing method for the specified page.
 
@@ -314,6 +368,31 @@ class System : public Serializable
     */
     bool load(Deserializer& in);
 
+    /**
+      Answers the number of bytes used by cloneState().
+
+      @return The size of the state snapshot
+    */
+    uInt32 stateSize() const;
+
+    /**
+      Copies the state of this system, its processor and all its devices
+      to the given buffer, as a raw snapshot (see Device::cloneState()).
+
+      @param state  The buffer of stateSize() bytes to copy the state to
+      @return  The number of bytes copied (always stateSize())
+    */
+    uInt32 cloneState(uInt8* state) const;
+
+    /**
+      Restores the state of this system, its processor and all its devices
+      from a snapshot which was taken by cloneState().
+
+      @param state  The buffer to restore the state from
+      @return  The number of bytes used from the buffer
+    */
+    uInt32 restoreState(const uInt8* state);
+
     /**
       Get a descriptor for the device name (used in error checking).
 
@@ -337,6 +416,9 @@ class System : public Serializable
     // Pointer to a dynamically allocated array of PageAccess structures
     PageAccess* myPageAccessTable;
 
+    // Incremented every time the page access table is changed
+    uInt32 myPageAccessGeneration;
+
     // Array of all the devices attached to the system
     Device* myDevices[100];
 
@@ -358,6 +440,9 @@ class System : public Serializable
     // Null device to use for page which are not installed
     NullDevice myNullDevice; 
 
+    // Random number generator used by the devices in the system
+    Random myRandom;
+
     // The current state of the Data Bus
     uInt8 myDataBusState;
 
@@ -39,12 +39,12 @@ typedef unsigned short uInt16;
 typedef signed int Int32;
 typedef unsigned int uInt32;
 
-#ifdef WII
-// Necessary for game loop that was overflowing the 32 bit length
-// after an hour and 11 minutes.
+// Types for 64-bit signed and unsigned integers
+// Originally needed for the Wii game loop, which was overflowing the
+// 32 bit length after an hour and 11 minutes; now also used for timing
+// and benchmarking on all platforms
 typedef signed long long Int64;
 typedef unsigned long long uInt64;
-#endif
 
 // The following code should provide access to the standard C++ objects and
 // types: cout, cerr, string, ostream, istream, etc.
@@ -49,6 +49,7 @@ MODULE_OBJS := \
 	src/emucore/SaveKey.o \
 	src/emucore/Serializer.o \
 	src/emucore/Settings.o \
+	src/emucore/SoundStats.o \
 	src/emucore/SpeakJet.o \
 	src/emucore/Switches.o \
 	src/emucore/StateManager.o \
@@ -33,7 +33,6 @@ SettingsGP2X::SettingsGP2X(OSystem* osystem)
   setInternal("zoom", "1");
   setInternal("fragsize", "256");
   setInternal("freq", "15700");
-  setInternal("tiafreq", "15700");
   setInternal("clipvol", "false");
   setInternal("rombrowse", "true");
   setInternal("romdir", "/mnt/sd/");
@@ -54,7 +54,7 @@ AudioDialog::AudioDialog(OSystem* osystem, DialogContainer* parent,
 
   // Set real dimensions
   _w = 35 * fontWidth + 10;
-  _h = 8 * (lineHeight + 4) + 10;
+  _h = 7 * (lineHeight + 4) + 10;
 
   // Volume
   xpos = 3 * fontWidth;  ypos = 10;
@@ -98,14 +98,6 @@ AudioDialog::AudioDialog(OSystem* osystem, DialogContainer* parent,
   wid.push_back(myFreqPopup);
   ypos += lineHeight + 4;
 
-  // TIA frequency
-  // ... use same items as above
-  myTiaFreqPopup = new PopUpWidget(this, font, xpos, ypos,
-                                   pwidth + myVolumeLabel->getWidth() - 4, lineHeight,
-                                   items, "TIA freq: ", lwidth);
-  wid.push_back(myTiaFreqPopup);
-  ypos += lineHeight + 4;
-
   // Clip volume
   myClipVolumeCheckbox = new CheckboxWidget(this, font, xpos+28, ypos,
                                             "Clip volume", 0);
@@ -146,9 +138,6 @@ void AudioDialog::loadConfig()
   // Output frequency
   myFreqPopup->setSelected(instance().settings().getString("freq"), "31400");
 
-  // TIA frequency
-  myTiaFreqPopup->setSelected(instance().settings().getString("tiafreq"), "31400");
-
   // Clip volume
   myClipVolumeCheckbox->setState(instance().settings().getBool("clipvol"));
 
@@ -175,9 +164,6 @@ void AudioDialog::saveConfig()
   // Output frequency
   settings.setString("freq", myFreqPopup->getSelectedTag());
 
-  // TIA frequency
-  settings.setString("tiafreq", myTiaFreqPopup->getSelectedTag());
-
   // Enable/disable volume clipping (requires a restart to take effect)
   settings.setBool("clipvol", myClipVolumeCheckbox->getState());
 
@@ -198,7 +184,6 @@ void AudioDialog::setDefaults()
 
   myFragsizePopup->setSelected("512", "");
   myFreqPopup->setSelected("31400", "");
-  myTiaFreqPopup->setSelected("31400", "");
 
   myClipVolumeCheckbox->setState(true);
   mySoundEnableCheckbox->setState(true);
@@ -216,7 +201,6 @@ void AudioDialog::handleSoundEnableChange(bool active)
   myVolumeLabel->setEnabled(active);
   myFragsizePopup->setEnabled(active);
   myFreqPopup->setEnabled(active);
-  myTiaFreqPopup->setEnabled(active);
   myClipVolumeCheckbox->setEnabled(active);
 }
 
@@ -44,7 +44,6 @@ class AudioDialog : public Dialog
     StaticTextWidget* myVolumeLabel;
     PopUpWidget*      myFragsizePopup;
     PopUpWidget*      myFreqPopup;
-    PopUpWidget*      myTiaFreqPopup;
     CheckboxWidget*   myClipVolumeCheckbox;
     CheckboxWidget*   mySoundEnableCheckbox;
 
@@ -20,8 +20,8 @@
 
 #include "Array.hxx"
 #include "OSystem.hxx"
-#include "Joystick.hxx"
-#include "Paddles.hxx"
+#include "Console.hxx"
+#include "EventHandler.hxx"
 #include "Settings.hxx"
 #include "StringList.hxx"
 #include "EventMappingWidget.hxx"
@@ -214,15 +214,16 @@ void InputDialog::saveConfig()
   // Joystick deadzone
   int deadzone = myDeadzone->getValue();
   instance().settings().setInt("joydeadzone", deadzone);
-  Joystick::setDeadZone(deadzone);
+  instance().eventHandler().setJoyDeadZone(deadzone);
 
   // Paddle mode
-  Paddles::setMouseIsPaddle(myPaddleMode->getValue());
+  instance().eventHandler().setPaddleMode(myPaddleMode->getValue());
 
   // Paddle speed
   int speed = myPaddleSpeed->getValue();
   instance().settings().setInt("pspeed", speed);
-  Paddles::setDigitalSpeed(speed);
+  if(&instance().console())
+    instance().console().setPaddleSpeed(speed);
 
   // AtariVox serial port
   instance().settings().setString("avoxport", myAVoxPort->getEditString());
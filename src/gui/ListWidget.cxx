@@ -25,6 +25,7 @@
 #include "OSystem.hxx"
 #include "Widget.hxx"
 #include "ScrollBarWidget.hxx"
+#include "Settings.hxx"
 #include "Dialog.hxx"
 #include "FrameBuffer.hxx"
 #include "ListWidget.hxx"
@@ -230,7 +231,7 @@ bool ListWidget::handleKeyDown(int ascii, int keycode, int modifiers)
       _quickSelectStr = (char)ascii;
     else
       _quickSelectStr += (char)ascii;
-    _quickSelectTime = time + _QUICK_SELECT_DELAY;
+    _quickSelectTime = time + instance().settings().getInt("listdelay");
 
     // FIXME: This is bad slow code (it scans the list linearly each time a
     // key is pressed); it could be much faster. Only of importance if we have
@@ -452,6 +453,3 @@ void ListWidget::abortEditMode()
   // Reset to normal data entry
   EditableWidget::abortEditMode();
 }
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int ListWidget::_QUICK_SELECT_DELAY = 300;
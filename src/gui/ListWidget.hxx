@@ -77,8 +77,6 @@ class ListWidget : public EditableWidget
     void startEditMode();
     void endEditMode();
 
-    static void setQuickSelectDelay(int time) { _QUICK_SELECT_DELAY = time; }
-
   protected:
     virtual void drawWidget(bool hilite)  = 0;
     virtual GUI::Rect getEditRect() const = 0;
@@ -113,9 +111,6 @@ class ListWidget : public EditableWidget
     string     _backupString;
     string     _quickSelectStr;
     int        _quickSelectTime;
-
-  private:
-    static int _QUICK_SELECT_DELAY;
 };
 
 #endif
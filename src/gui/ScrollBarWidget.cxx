@@ -22,6 +22,7 @@
 #include "OSystem.hxx"
 #include "Dialog.hxx"
 #include "FrameBuffer.hxx"
+#include "Settings.hxx"
 #include "ScrollBarWidget.hxx"
 #include "bspf.hxx"
 
@@ -135,10 +136,11 @@ void ScrollBarWidget::handleMouseWheel(int x, int y, int direction)
   if(_numEntries < _entriesPerPage)
     return;
 
+  int lines = instance().settings().getInt("mwheel");
   if(direction < 0)
-    _currentPos -= _WHEEL_LINES;
+    _currentPos -= lines;
   else
-    _currentPos += _WHEEL_LINES;
+    _currentPos += lines;
 
   // Make sure that _currentPos is still inside the bounds
   checkBounds(old_pos);
@@ -278,6 +280,3 @@ void ScrollBarWidget::drawWidget(bool hilite)
     s.hLine(_x + 2, y + 2, _x + _w - 3, kWidColor);
   }
 }
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int ScrollBarWidget::_WHEEL_LINES = 4;
@@ -51,8 +51,6 @@ class ScrollBarWidget : public Widget, public CommandSender
     // should these accessors force a redraw?
     void recalc();
 
-    static void setWheelLines(int lines) { _WHEEL_LINES = lines; }
-
   private:
     void drawWidget(bool hilite);
     void checkBounds(int old_pos);
@@ -77,8 +75,6 @@ class ScrollBarWidget : public Widget, public CommandSender
     int _sliderHeight;
     int _sliderPos;
     int _sliderDeltaMouseDownPos;
-
-    static int _WHEEL_LINES;
 };
 
 #endif
@@ -25,9 +25,7 @@
 
 #include "Dialog.hxx"
 #include "OSystem.hxx"
-#include "ListWidget.hxx"
 #include "PopUpWidget.hxx"
-#include "ScrollBarWidget.hxx"
 #include "Settings.hxx"
 #include "StringList.hxx"
 #include "TabWidget.hxx"
@@ -333,14 +331,10 @@ void UIDialog::saveConfig()
     myPalettePopup->getSelectedTag());
 
   // Listwidget quick delay
-  int delay = myListDelaySlider->getValue();
-  instance().settings().setInt("listdelay", delay);
-  ListWidget::setQuickSelectDelay(delay);
+  instance().settings().setInt("listdelay", myListDelaySlider->getValue());
 
   // Mouse wheel lines
-  int mw = myWheelLinesSlider->getValue();
-  instance().settings().setInt("mwheel", mw);
-  ScrollBarWidget::setWheelLines(mw);
+  instance().settings().setInt("mwheel", myWheelLinesSlider->getValue());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -0,0 +1,401 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <cstring>
+#include <unistd.h>
+
+#include "bspf.hxx"
+#include "Console.hxx"
+#include "Control.hxx"
+#include "Event.hxx"
+#include "EventHandler.hxx"
+#include "M6532.hxx"
+#include "OSystemHeadless.hxx"
+#include "Settings.hxx"
+#include "SettingsUNIX.hxx"
+#include "Switches.hxx"
+#include "System.hxx"
+#include "ThreadPool.hxx"
+#include "TIA.hxx"
+
+#include "libstella.h"
+
+struct stella_t
+{
+  OSystemHeadless* osystem;
+  Settings* settings;
+  Console* console;
+  Event* event;
+};
+
+struct stella_batch_t
+{
+  stella_t** instances;
+  uInt32 count;
+  ThreadPool* pool;
+
+  stella_obs_format format;
+  uInt32 downsample;
+  stella_batch_layout layout;
+
+  // The observation buffer, and the block it was aligned within
+  uInt8* observations;
+  uInt8* memory;
+
+  // The luminance of each palette entry, for STELLA_OBS_GRAYSCALE
+  uInt8 luma[256];
+
+  stella_reward_fn reward;
+  void* user;
+};
+
+// The events for each of the stella_input values, in the same order
+static const Event::Type ourInputEvents[STELLA_NUM_INPUTS] = {
+  Event::ConsoleColor, Event::ConsoleBlackWhite,
+  Event::ConsoleLeftDifficultyA, Event::ConsoleLeftDifficultyB,
+  Event::ConsoleRightDifficultyA, Event::ConsoleRightDifficultyB,
+  Event::ConsoleSelect, Event::ConsoleReset,
+
+  Event::JoystickZeroUp, Event::JoystickZeroDown,
+  Event::JoystickZeroLeft, Event::JoystickZeroRight,
+  Event::JoystickZeroFire1, Event::JoystickZeroFire2, Event::JoystickZeroFire3,
+  Event::JoystickOneUp, Event::JoystickOneDown,
+  Event::JoystickOneLeft, Event::JoystickOneRight,
+  Event::JoystickOneFire1, Event::JoystickOneFire2, Event::JoystickOneFire3,
+
+  Event::PaddleZeroDecrease, Event::PaddleZeroIncrease, Event::PaddleZeroFire,
+  Event::PaddleOneDecrease, Event::PaddleOneIncrease, Event::PaddleOneFire,
+  Event::PaddleTwoDecrease, Event::PaddleTwoIncrease, Event::PaddleTwoFire,
+  Event::PaddleThreeDecrease, Event::PaddleThreeIncrease,
+    Event::PaddleThreeFire,
+
+  Event::KeyboardZero1, Event::KeyboardZero2, Event::KeyboardZero3,
+  Event::KeyboardZero4, Event::KeyboardZero5, Event::KeyboardZero6,
+  Event::KeyboardZero7, Event::KeyboardZero8, Event::KeyboardZero9,
+  Event::KeyboardZeroStar, Event::KeyboardZero0, Event::KeyboardZeroPound,
+  Event::KeyboardOne1, Event::KeyboardOne2, Event::KeyboardOne3,
+  Event::KeyboardOne4, Event::KeyboardOne5, Event::KeyboardOne6,
+  Event::KeyboardOne7, Event::KeyboardOne8, Event::KeyboardOne9,
+  Event::KeyboardOneStar, Event::KeyboardOne0, Event::KeyboardOnePound,
+
+  Event::SALeftAxis0Value, Event::SALeftAxis1Value,
+  Event::SARightAxis0Value, Event::SARightAxis1Value,
+  Event::MouseAxisXValue, Event::MouseAxisYValue, Event::MouseButtonValue
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+stella_t* stella_create(const void* rom, unsigned int size,
+                        const char* const* settings)
+{
+  if(rom == NULL || size == 0)
+    return NULL;
+
+  stella_t* s = new stella_t;
+  s->osystem  = new OSystemHeadless();
+  s->settings = new SettingsUNIX(s->osystem);
+  s->console  = NULL;
+
+  // Only the settings given here are used, so that results don't depend
+  // on whoever's configuration file happens to be around
+  // RAM starts with the same contents every time, unless asked otherwise
+  s->settings->setInt("randseed", 1);
+  if(settings)
+    for(int i = 0; settings[i] && settings[i+1]; i += 2)
+      s->settings->setString(settings[i], settings[i+1]);
+
+  // Sound and framebuffer are never opened; make sure nothing asks for them
+  s->settings->setBool("sound", false);
+  s->settings->setBool("showinfo", false);
+  s->settings->validate();
+
+  if(s->osystem->create())
+  {
+    string md5 = "";
+    s->console = s->osystem->openConsole((const uInt8*) rom, size, md5);
+  }
+  else
+    cerr << "ERROR: Couldn't create OSystem" << endl;
+
+  if(!s->console)
+  {
+    stella_destroy(s);
+    return NULL;
+  }
+  s->event = s->osystem->eventHandler().event();
+
+  return s;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void stella_destroy(stella_t* s)
+{
+  if(!s)
+    return;
+
+  delete s->console;
+  delete s->osystem;
+  delete s->settings;
+  delete s;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void stella_reset(stella_t* s)
+{
+  s->console->system().reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void stella_set_input(stella_t* s, stella_input input, int value)
+{
+  if(input >= 0 && input < STELLA_NUM_INPUTS)
+    s->event->set(ourInputEvents[input], value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void stella_step(stella_t* s)
+{
+  // This is what the event loop does once per frame, minus the
+  // StateManager and cheats
+  Console& console = *s->console;
+  console.controller(Controller::Left).update();
+  console.controller(Controller::Right).update();
+  console.switches().update();
+
+  console.tia().update();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const unsigned char* stella_framebuffer(stella_t* s, unsigned int* width,
+                                        unsigned int* height)
+{
+  TIA& tia = s->console->tia();
+  if(width)  *width  = tia.width();
+  if(height) *height = tia.height();
+
+  return tia.currentFrameBuffer();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const unsigned int* stella_palette(stella_t* s)
+{
+  return s->console->palette(s->settings->getString("palette"));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unsigned char* stella_ram(stella_t* s)
+{
+  return s->console->riot().ram();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unsigned int stella_state_size(stella_t* s)
+{
+  return s->console->stateSize();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unsigned long long stella_clone_state(stella_t* s, void* state)
+{
+  return s->console->cloneState((uInt8*) state);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void stella_restore_state(stella_t* s, const void* state)
+{
+  s->console->restoreState((const uInt8*) state);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Steps one instance of a batch, and fills in its observation
+class BatchStep : public ThreadPool::Job
+{
+  public:
+    BatchStep(stella_batch_t& batch, uInt32 frames)
+      : myBatch(batch), myFrames(frames) { }
+
+    void run(uInt32 index)
+    {
+      stella_batch_t& b = myBatch;
+      stella_t* s = b.instances[index];
+
+      float reward = 0;
+      for(uInt32 i = 0; i < myFrames; ++i)
+      {
+        stella_step(s);
+        if(b.reward)
+          reward += b.reward(s, b.user);
+      }
+
+      const stella_batch_layout& layout = b.layout;
+      uInt8* obs = b.observations + index * layout.stride;
+      TIA& tia = s->console->tia();
+      const uInt8* frame = tia.currentFrameBuffer();
+      uInt32 pitch = tia.width(), d = b.downsample;
+
+      if(b.format == STELLA_OBS_INDEXED)
+      {
+        for(uInt32 y = 0; y < layout.height; ++y)
+        {
+          const uInt8* src = frame + y * d * pitch;
+          for(uInt32 x = 0; x < layout.width; ++x)
+            *obs++ = src[x * d];
+        }
+      }
+      else
+      {
+        for(uInt32 y = 0; y < layout.height; ++y)
+        {
+          const uInt8* src = frame + y * d * pitch;
+          for(uInt32 x = 0; x < layout.width; ++x, src += d)
+          {
+            uInt32 sum = 0;
+            for(uInt32 j = 0; j < d; ++j)
+              for(uInt32 i = 0; i < d; ++i)
+                sum += b.luma[src[j * pitch + i]];
+            *obs++ = sum / (d * d);
+          }
+        }
+      }
+
+      obs = b.observations + index * layout.stride;
+      memcpy(obs + layout.ram_offset, s->console->riot().ram(), 128);
+      memcpy(obs + layout.reward_offset, &reward, sizeof(float));
+    }
+
+  private:
+    stella_batch_t& myBatch;
+    uInt32 myFrames;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+stella_batch_t* stella_batch_create(const void* rom, unsigned int size,
+                                    const char* const* settings,
+                                    unsigned int count, unsigned int threads,
+                                    stella_obs_format format,
+                                    unsigned int downsample)
+{
+  if(count == 0 || downsample == 0)
+    return NULL;
+
+  stella_batch_t* b = new stella_batch_t;
+  b->instances = new stella_t*[count];
+  b->count = 0;
+  b->pool = NULL;
+  b->format = format;
+  b->downsample = downsample;
+  b->observations = b->memory = NULL;
+  b->reward = NULL;
+  b->user = NULL;
+
+  for(; b->count < count; ++b->count)
+  {
+    b->instances[b->count] = stella_create(rom, size, settings);
+    if(!b->instances[b->count])
+    {
+      stella_batch_destroy(b);
+      return NULL;
+    }
+  }
+
+  // All the instances run the same ROM, so they all have the same frame
+  // size and palette
+  unsigned int width, height;
+  stella_framebuffer(b->instances[0], &width, &height);
+  const unsigned int* palette = stella_palette(b->instances[0]);
+  for(int i = 0; i < 256; ++i)
+  {
+    uInt8 r = (palette[i] >> 16) & 0xff;
+    uInt8 g = (palette[i] >> 8) & 0xff;
+    uInt8 bl = palette[i] & 0xff;
+    b->luma[i] = (uInt8)((float)r * 0.2989 + (float)g * 0.5870 +
+                         (float)bl * 0.1140);
+  }
+
+  stella_batch_layout& layout = b->layout;
+  layout.width  = width / downsample;
+  layout.height = height / downsample;
+  layout.ram_offset = (layout.width * layout.height + 63) & ~63;
+  layout.reward_offset = layout.ram_offset + 128;
+  layout.stride = (layout.reward_offset + sizeof(float) + 63) & ~63;
+
+  b->memory = new uInt8[count * layout.stride + 63];
+  b->observations = (uInt8*)(((size_t)b->memory + 63) & ~(size_t)63);
+  memset(b->observations, 0, count * layout.stride);
+
+  if(threads == 0)
+  {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    threads = online > 0 ? (unsigned int)online : 1;
+  }
+  b->pool = new ThreadPool(BSPF_min(threads, count));
+
+  return b;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void stella_batch_destroy(stella_batch_t* b)
+{
+  if(!b)
+    return;
+
+  delete b->pool;
+  for(uInt32 i = 0; i < b->count; ++i)
+    stella_destroy(b->instances[i]);
+  delete[] b->instances;
+  delete[] b->memory;
+  delete b;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unsigned int stella_batch_size(stella_batch_t* b)
+{
+  return b->count;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+stella_t* stella_batch_instance(stella_batch_t* b, unsigned int index)
+{
+  return index < b->count ? b->instances[index] : NULL;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void stella_batch_set_reward(stella_batch_t* b, stella_reward_fn fn,
+                             void* user)
+{
+  b->reward = fn;
+  b->user = user;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void stella_batch_step(stella_batch_t* b, unsigned int frames)
+{
+  BatchStep step(*b, frames);
+  b->pool->run(step, b->count);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void stella_batch_get_layout(stella_batch_t* b, stella_batch_layout* layout)
+{
+  *layout = b->layout;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const unsigned char* stella_batch_observations(stella_batch_t* b)
+{
+  return b->observations;
+}
@@ -0,0 +1,312 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef LIBSTELLA_H
+#define LIBSTELLA_H
+
+/**
+  A small C interface to the emulation core, for programs which want to
+  drive the emulation themselves (test farms, machine learning, scripting
+  languages through their C foreign function interface).
+
+  An instance owns one console, but no window, sound device or event
+  loop.  Inputs are set directly, a frame is emulated by stella_step(),
+  and the resulting frame is read from stella_framebuffer() as one byte
+  (a palette index) per pixel.
+
+  Instances share no emulation state, so any number of them may run at
+  once, each in its own thread (an instance must only be used by one
+  thread at a time), and may be created and destroyed from any thread.
+  The emulation is deterministic: two instances created with the same ROM
+  and settings, and given the same inputs, produce the same frames.
+
+  Typical use:
+
+    stella_t* s = stella_create(rom, size, NULL);
+    for(;;)
+    {
+      stella_set_input(s, STELLA_JOY0_FIRE, 1);
+      stella_step(s);
+      pixels = stella_framebuffer(s, &width, &height);
+      ...
+    }
+    stella_destroy(s);
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct stella_t stella_t;
+
+/**
+  The inputs which can be set by stella_set_input().  The value for the
+  switches, joystick directions, buttons and keypad keys is 0 (released)
+  or 1 (pressed); the axis values are signed, as used by the driving and
+  booster grip controllers (STELLA_SA_*) or the mouse (STELLA_MOUSE_*,
+  relative motion since the last frame).
+*/
+typedef enum
+{
+  STELLA_CONSOLE_COLOR, STELLA_CONSOLE_BLACKWHITE,
+  STELLA_CONSOLE_LEFT_DIFFICULTY_A, STELLA_CONSOLE_LEFT_DIFFICULTY_B,
+  STELLA_CONSOLE_RIGHT_DIFFICULTY_A, STELLA_CONSOLE_RIGHT_DIFFICULTY_B,
+  STELLA_CONSOLE_SELECT, STELLA_CONSOLE_RESET,
+
+  STELLA_JOY0_UP, STELLA_JOY0_DOWN, STELLA_JOY0_LEFT, STELLA_JOY0_RIGHT,
+  STELLA_JOY0_FIRE, STELLA_JOY0_FIRE2, STELLA_JOY0_FIRE3,
+  STELLA_JOY1_UP, STELLA_JOY1_DOWN, STELLA_JOY1_LEFT, STELLA_JOY1_RIGHT,
+  STELLA_JOY1_FIRE, STELLA_JOY1_FIRE2, STELLA_JOY1_FIRE3,
+
+  STELLA_PADDLE0_DECREASE, STELLA_PADDLE0_INCREASE, STELLA_PADDLE0_FIRE,
+  STELLA_PADDLE1_DECREASE, STELLA_PADDLE1_INCREASE, STELLA_PADDLE1_FIRE,
+  STELLA_PADDLE2_DECREASE, STELLA_PADDLE2_INCREASE, STELLA_PADDLE2_FIRE,
+  STELLA_PADDLE3_DECREASE, STELLA_PADDLE3_INCREASE, STELLA_PADDLE3_FIRE,
+
+  STELLA_KEYPAD0_1, STELLA_KEYPAD0_2, STELLA_KEYPAD0_3,
+  STELLA_KEYPAD0_4, STELLA_KEYPAD0_5, STELLA_KEYPAD0_6,
+  STELLA_KEYPAD0_7, STELLA_KEYPAD0_8, STELLA_KEYPAD0_9,
+  STELLA_KEYPAD0_STAR, STELLA_KEYPAD0_0, STELLA_KEYPAD0_POUND,
+  STELLA_KEYPAD1_1, STELLA_KEYPAD1_2, STELLA_KEYPAD1_3,
+  STELLA_KEYPAD1_4, STELLA_KEYPAD1_5, STELLA_KEYPAD1_6,
+  STELLA_KEYPAD1_7, STELLA_KEYPAD1_8, STELLA_KEYPAD1_9,
+  STELLA_KEYPAD1_STAR, STELLA_KEYPAD1_0, STELLA_KEYPAD1_POUND,
+
+  STELLA_SA_LEFT_AXIS0, STELLA_SA_LEFT_AXIS1,
+  STELLA_SA_RIGHT_AXIS0, STELLA_SA_RIGHT_AXIS1,
+  STELLA_MOUSE_X, STELLA_MOUSE_Y, STELLA_MOUSE_BUTTON,
+
+  STELLA_NUM_INPUTS
+} stella_input;
+
+/**
+  Create an instance running the given ROM image.  The image is copied,
+  and its properties (cartridge type, controllers, display format) are
+  looked up by MD5 in the usual properties database.
+
+  @param rom       The ROM image
+  @param size      The size of the ROM image in bytes
+  @param settings  NULL, or a NULL-terminated list of setting name/value
+                   pairs, the same as the commandline options without
+                   the '-' (for example { "type", "F8", "cpu", "low",
+                   NULL }).  The user's configuration file isn't read.
+                   The 'randseed' setting, which decides the random
+                   contents of RAM at power-on, defaults to 1 rather
+                   than a new seed each time.
+
+  @return  The new instance, or NULL if the ROM couldn't be opened
+*/
+stella_t* stella_create(const void* rom, unsigned int size,
+                        const char* const* settings);
+
+/**
+  Destroy an instance created by stella_create().
+*/
+void stella_destroy(stella_t* s);
+
+/**
+  Reset the console to its power-on state (the same as switching it off
+  and on again, not the same as pressing the reset switch).
+*/
+void stella_reset(stella_t* s);
+
+/**
+  Set the value of an input.  Inputs keep their value until they're set
+  again, and take effect at the start of the next stella_step().
+*/
+void stella_set_input(stella_t* s, stella_input input, int value);
+
+/**
+  Emulate one frame.
+*/
+void stella_step(stella_t* s);
+
+/**
+  Get the most recently emulated frame, as one palette index per pixel.
+  The pointer stays valid until the next call to stella_step().
+
+  @param width   Set to the width of the frame in pixels (may be NULL)
+  @param height  Set to the height of the frame in pixels (may be NULL)
+  @return  The pixels, row by row
+*/
+const unsigned char* stella_framebuffer(stella_t* s, unsigned int* width,
+                                        unsigned int* height);
+
+/**
+  Get the palette for stella_framebuffer(), as 256 entries of 0x00RRGGBB.
+  This depends on the display format of the ROM, and on the 'palette'
+  setting given to stella_create().
+*/
+const unsigned int* stella_palette(stella_t* s);
+
+/**
+  Get the 128 bytes of RAM in the console.  They may be read or changed
+  between calls to stella_step().
+*/
+unsigned char* stella_ram(stella_t* s);
+
+/**
+  Get the number of bytes needed for a snapshot of the emulation state.
+  This doesn't change for the lifetime of an instance.
+*/
+unsigned int stella_state_size(stella_t* s);
+
+/**
+  Copy the emulation state to a buffer of stella_state_size() bytes.
+  The snapshot can be restored into any instance in this process which
+  is running the same ROM with the same settings.
+
+  @return  A 64-bit hash of the snapshot
+*/
+unsigned long long stella_clone_state(stella_t* s, void* state);
+
+/**
+  Restore the emulation state from a snapshot taken by stella_clone_state().
+*/
+void stella_restore_state(stella_t* s, const void* state);
+
+/**
+  A batch of instances running the same ROM, which are stepped together
+  on a pool of threads.  After each stella_batch_step(), the observation
+  of every instance is in one contiguous buffer, laid out as described
+  by stella_batch_layout.
+
+  Typical use:
+
+    stella_batch_t* b = stella_batch_create(rom, size, NULL, 256, 0,
+                                            STELLA_OBS_GRAYSCALE, 2);
+    stella_batch_get_layout(b, &layout);
+    for(;;)
+    {
+      for(i = 0; i < 256; ++i)
+        stella_set_input(stella_batch_instance(b, i), ...);
+      stella_batch_step(b, 4);
+      obs = stella_batch_observations(b);
+      ... obs + i * layout.stride is the observation of instance i ...
+    }
+    stella_batch_destroy(b);
+*/
+typedef struct stella_batch_t stella_batch_t;
+
+/**
+  The form of the frame in an observation.  Either way, the frame can be
+  downsampled by a whole factor in both directions.
+*/
+typedef enum
+{
+  STELLA_OBS_INDEXED,    /* One palette index per pixel (taking the
+                            top-left pixel of each downsampled block) */
+  STELLA_OBS_GRAYSCALE   /* One luminance byte per pixel (averaged over
+                            each downsampled block) */
+} stella_obs_format;
+
+/**
+  Where things are in the observation buffer.  The buffer starts on a
+  64-byte boundary, and so does the observation of each instance, so
+  that no two instances share a cache line.  Each observation holds:
+
+    frame   width * height bytes, row by row, at offset 0
+    ram     the 128 bytes of console RAM, at ram_offset
+    reward  a float, the sum of the rewards for the frames emulated by
+            the last stella_batch_step(), at reward_offset
+*/
+typedef struct
+{
+  unsigned int stride;         /* Bytes from one observation to the next */
+  unsigned int width, height;  /* Size of the (downsampled) frame */
+  unsigned int ram_offset;
+  unsigned int reward_offset;
+} stella_batch_layout;
+
+/**
+  Computes the reward for one frame of an instance in a batch, usually
+  from the change in the score held in its RAM.  It's called from the
+  thread stepping that instance, once after every frame.
+*/
+typedef float (*stella_reward_fn)(stella_t* s, void* user);
+
+/**
+  Create a batch of instances.  The instances are created one after the
+  other, the same way as by stella_create().
+
+  @param rom         The ROM image
+  @param size        The size of the ROM image in bytes
+  @param settings    As for stella_create()
+  @param count       The number of instances in the batch
+  @param threads     The number of threads to step them on (including the
+                     one calling stella_batch_step()), or 0 for one per
+                     online processor
+  @param format      The form of the frames in the observations
+  @param downsample  The factor to shrink the frames by (1 for none)
+
+  @return  The new batch, or NULL if the ROM couldn't be opened
+*/
+stella_batch_t* stella_batch_create(const void* rom, unsigned int size,
+                                    const char* const* settings,
+                                    unsigned int count, unsigned int threads,
+                                    stella_obs_format format,
+                                    unsigned int downsample);
+
+/**
+  Destroy a batch created by stella_batch_create(), including all its
+  instances.
+*/
+void stella_batch_destroy(stella_batch_t* b);
+
+/**
+  Get the number of instances in a batch.
+*/
+unsigned int stella_batch_size(stella_batch_t* b);
+
+/**
+  Get one of the instances of a batch, for setting its inputs, resetting
+  it, or taking and restoring snapshots.  It must not be used while
+  stella_batch_step() is running, nor destroyed by stella_destroy().
+*/
+stella_t* stella_batch_instance(stella_batch_t* b, unsigned int index);
+
+/**
+  Set the function used to compute rewards, or NULL (the default) for
+  rewards which are always 0.
+*/
+void stella_batch_set_reward(stella_batch_t* b, stella_reward_fn fn,
+                             void* user);
+
+/**
+  Emulate the given number of frames on every instance, using the inputs
+  set on each beforehand, and then fill in their observations.  Returns
+  once all the instances are done.
+*/
+void stella_batch_step(stella_batch_t* b, unsigned int frames);
+
+/**
+  Get the layout of the observation buffer.
+*/
+void stella_batch_get_layout(stella_batch_t* b, stella_batch_layout* layout);
+
+/**
+  Get the observation buffer, filled in by the last stella_batch_step().
+  It stays at the same address for the lifetime of the batch.
+*/
+const unsigned char* stella_batch_observations(stella_batch_t* b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,151 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+/**
+  Headless throughput benchmark.  Each ROM given on the commandline is
+  opened as a Console (without any video, audio or event loop), and
+  TIA::update() is called in a tight loop for the requested number of
+  frames.  Emulated frames/sec, host ns/frame and 6502 instructions/sec
+  are then reported per ROM.
+
+  Usage: stella-bench [-frames N] [-<setting> <value> ...] rom1 [rom2 ...]
+
+  Any other '-<setting> <value>' pair is passed through to the Settings
+  object, so for example '-cpu low' benchmarks the M6502Low core, and
+  '-decode address' benchmarks per-address memory decoding (compare it
+  with '-decode page' on bankswitched ROMs such as F8, F6, F4, E0 and
+  0840).  The page size in use is reported alongside the results.
+*/
+
+#include <cstdlib>
+#include <iomanip>
+#include <sys/time.h>
+
+#include "bspf.hxx"
+#include "Console.hxx"
+#include "M6502.hxx"
+#include "OSystemHeadless.hxx"
+#include "Settings.hxx"
+#include "SettingsUNIX.hxx"
+#include "System.hxx"
+#include "TIA.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static uInt64 getTimeInMicros()
+{
+  timeval now;
+  gettimeofday(&now, 0);
+
+  return (uInt64)now.tv_sec * 1000000 + (uInt64)now.tv_usec;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static bool benchROM(OSystem& osystem, const string& romfile, uInt32 frames)
+{
+  string md5 = "";
+  Console* console = osystem.openConsole(romfile, md5);
+  if(!console)
+    return false;
+
+  TIA& tia = console->tia();
+  System& system = console->system();
+  M6502& cpu = system.m6502();
+
+  uInt32 startInstructions = (uInt32) cpu.totalInstructionCount();
+  uInt64 startTime = getTimeInMicros();
+
+  for(uInt32 i = 0; i < frames; ++i)
+    tia.update();
+
+  uInt64 elapsed = getTimeInMicros() - startTime;
+  uInt32 instructions =
+    (uInt32) cpu.totalInstructionCount() - startInstructions;
+
+  double seconds = elapsed > 0 ? (double) elapsed / 1000000.0 : 1e-6;
+  cout << setw(32) << left << console->properties().get(Cartridge_Name)
+       << right << setw(8)  << frames << " frames  "
+       << fixed << setprecision(1)
+       << setw(10) << (frames / seconds) << " fps  "
+       << setw(10) << ((double) elapsed * 1000.0 / frames) << " ns/frame  "
+       << setprecision(2)
+       << setw(8)  << (instructions / seconds / 1000000.0) << " MIPS  "
+       << setw(4)  << (1 << system.pageShift()) << "B pages"
+       << endl;
+
+  delete console;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int argc, char* argv[])
+{
+  OSystemHeadless* osystem = new OSystemHeadless();
+  SettingsUNIX settings(osystem);
+  settings.loadConfig();
+
+  uInt32 frames = 3000;
+  StringList roms;
+  for(int i = 1; i < argc; ++i)
+  {
+    string key = argv[i];
+    if(key[0] == '-' && i + 1 < argc)
+    {
+      key = key.substr(1, key.length());
+      string value = argv[++i];
+      if(key == "frames")
+        frames = atoi(value.c_str());
+      else
+        settings.setString(key, value);
+    }
+    else
+      roms.push_back(key);
+  }
+
+  if(roms.isEmpty() || frames == 0)
+  {
+    cerr << "Usage: stella-bench [-frames N] [-<setting> <value> ...] "
+         << "rom1 [rom2 ...]" << endl;
+    delete osystem;
+    return 1;
+  }
+
+  // Sound and framebuffer are never opened; make sure nothing asks for them
+  settings.setBool("sound", false);
+  settings.setBool("showinfo", false);
+  settings.validate();
+
+  if(!osystem->create())
+  {
+    cerr << "ERROR: Couldn't create OSystem" << endl;
+    delete osystem;
+    return 1;
+  }
+
+  int failures = 0;
+  for(uInt32 i = 0; i < roms.size(); ++i)
+  {
+    if(!benchROM(*osystem, roms[i], frames))
+    {
+      cerr << "ERROR: Couldn't create console for " << roms[i] << endl;
+      ++failures;
+    }
+  }
+
+  delete osystem;
+  return failures;
+}
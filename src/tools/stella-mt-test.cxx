@@ -0,0 +1,205 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+/**
+  Test that libstella instances running in parallel threads don't disturb
+  each other.  The same set of instances is run twice, once one after the
+  other on a single thread and once all at the same time on a thread each,
+  and the hashes of every instance's frames and RAM must come out the same
+  both times.  Each instance is given one of a few RAM seeds; instances
+  with the same seed must come out the same, and instances with different
+  seeds must come out different, so that a run which ignores its seed (or
+  shares its state with another) can't pass.
+
+  The ROM is built in, so the test needs no files: it draws its RAM into
+  the playfield and mixes it up every frame, so that everything it shows
+  depends on the random contents of RAM at power-on.
+
+  Usage: stella-mt-test [frames]
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <SDL.h>
+#include <SDL_thread.h>
+
+#include "bspf.hxx"
+#include "../libstella/libstella.h"
+
+// The number of instances, each run on its own thread, and the number of
+// RAM seeds they're shared between
+static const uInt32 kNumInstances = 16;
+static const uInt32 kNumSeeds = 4;
+
+/**
+  The built in ROM, for a 4K cartridge at $F000:
+
+    F000  SEI / CLD / LDX #$FF / TXS
+    F005  frame: VBLANK and three lines of VSYNC
+    F015  add to each byte of RAM $80-$FD the one after it, with carry
+    F026  4 more lines of VBLANK, then end VBLANK
+    F031  192 lines with PF1, PF2 and COLUPF set from RAM $80-$FF
+    F047  30 lines of overscan, and JMP to the next frame
+*/
+static const uInt8 ourProgram[] = {
+  0x78, 0xd8, 0xa2, 0xff, 0x9a,                    // F000
+  0xa9, 0x02, 0x85, 0x01, 0x85, 0x00,              // F005
+  0x85, 0x02, 0x85, 0x02, 0x85, 0x02,
+  0xa9, 0x00, 0x85, 0x00,
+  0xa0, 0x00, 0x18,                                // F015
+  0xb9, 0x80, 0x00, 0x79, 0x81, 0x00,
+  0x99, 0x80, 0x00, 0xc8, 0xc0, 0x7e, 0xd0, 0xf2,
+  0xa2, 0x04, 0x85, 0x02, 0xca, 0xd0, 0xfb,        // F026
+  0xa9, 0x00, 0x85, 0x01,
+  0xa2, 0x00,                                      // F031
+  0x85, 0x02, 0x8a, 0x29, 0x7f, 0xa8, 0xb9, 0x80, 0x00,
+  0x85, 0x0e, 0x85, 0x08, 0x85, 0x0f,
+  0xe8, 0xe0, 0xc0, 0xd0, 0xec,
+  0xa9, 0x02, 0x85, 0x01,                          // F047
+  0xa2, 0x1e, 0x85, 0x02, 0xca, 0xd0, 0xfb,
+  0x4c, 0x05, 0xf0
+};
+
+// The outcome of running one instance
+struct Result
+{
+  uInt32 seed;
+  uInt64 frames, ram;
+  bool opened;
+};
+
+static uInt8 ourRom[4096];
+static uInt32 ourNumFrames = 600;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static uInt64 hash(uInt64 hash, const uInt8* data, uInt32 size)
+{
+  // FNV-1a
+  for(uInt32 i = 0; i < size; ++i)
+    hash = (hash ^ data[i]) * 0x100000001b3ULL;
+  return hash;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static int runInstance(void* r)
+{
+  Result& result = *(Result*) r;
+  result.frames = result.ram = 0xcbf29ce484222325ULL;
+
+  char seed[16];
+  sprintf(seed, "%u", result.seed);
+  const char* settings[] = { "randseed", seed, NULL };
+
+  stella_t* s = stella_create(ourRom, sizeof(ourRom), settings);
+
+  result.opened = s != NULL;
+  if(!s)
+    return 0;
+
+  for(uInt32 frame = 0; frame < ourNumFrames; ++frame)
+  {
+    stella_step(s);
+
+    unsigned int width, height;
+    const unsigned char* pixels = stella_framebuffer(s, &width, &height);
+    result.frames = hash(result.frames, pixels, width * height);
+    result.ram = hash(result.ram, stella_ram(s), 128);
+  }
+
+  stella_destroy(s);
+
+  return 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int argc, char* argv[])
+{
+  if(argc > 1)
+    ourNumFrames = atoi(argv[1]);
+
+  memset(ourRom, 0xea, sizeof(ourRom));  // NOP
+  memcpy(ourRom, ourProgram, sizeof(ourProgram));
+  ourRom[0xffc] = 0x00;  // Reset vector
+  ourRom[0xffd] = 0xf0;
+
+  Result serial[kNumInstances], parallel[kNumInstances];
+  for(uInt32 i = 0; i < kNumInstances; ++i)
+    serial[i].seed = parallel[i].seed = 1 + i % kNumSeeds;
+
+  // One after the other
+  for(uInt32 i = 0; i < kNumInstances; ++i)
+    runInstance(&serial[i]);
+
+  // All at once
+  SDL_Thread* threads[kNumInstances];
+  for(uInt32 i = 0; i < kNumInstances; ++i)
+    threads[i] = SDL_CreateThread(runInstance, &parallel[i]);
+  for(uInt32 i = 0; i < kNumInstances; ++i)
+    SDL_WaitThread(threads[i], NULL);
+
+  uInt32 failures = 0;
+  for(uInt32 i = 0; i < kNumInstances; ++i)
+  {
+    const Result& s = serial[i];
+    const Result& p = parallel[i];
+    const Result& first = serial[i % kNumSeeds];
+
+    cout << "Instance " << i << " (seed " << s.seed << "): ";
+    if(!s.opened || !p.opened)
+    {
+      cout << "FAIL (couldn't create instance)" << endl;
+      ++failures;
+    }
+    else if(s.frames != first.frames || s.ram != first.ram)
+    {
+      cout << "FAIL (differs from instance " << i % kNumSeeds
+           << ", which has the same seed)" << endl;
+      ++failures;
+    }
+    else if(s.frames != p.frames || s.ram != p.ram)
+    {
+      cout << "FAIL (" << (s.frames != p.frames ? "frames" : "RAM")
+           << " differ between the serial and parallel runs)" << endl;
+      ++failures;
+    }
+    else
+      cout << "OK" << endl;
+  }
+
+  // The first instance of each seed against the first of every other seed
+  for(uInt32 i = 0; i < kNumSeeds; ++i)
+  {
+    for(uInt32 j = i + 1; j < kNumSeeds; ++j)
+    {
+      if(serial[i].frames == serial[j].frames || serial[i].ram == serial[j].ram)
+      {
+        cout << "FAIL (seeds " << serial[i].seed << " and " << serial[j].seed
+             << " give the same "
+             << (serial[i].frames == serial[j].frames ? "frames" : "RAM")
+             << ")" << endl;
+        ++failures;
+      }
+    }
+  }
+
+  cout << kNumInstances << " instances, " << ourNumFrames << " frames: "
+       << (failures == 0 ? "OK" : "FAILED") << endl;
+
+  return failures == 0 ? 0 : 1;
+}
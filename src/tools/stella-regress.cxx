@@ -0,0 +1,580 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+/**
+  Regression runner for a ROM library.  Every ROM given on the commandline
+  (or found in a directory given on the commandline) is run headless for
+  the requested number of frames, with the same scripted inputs each time,
+  and each frame of video and sound is hashed.  The ROMs are run in
+  parallel on all processors.
+
+  The hashes are compared with those in a golden file, written by an
+  earlier run with '-update 1', and every ROM is reported as OK, DIFF
+  (with the frames where it first went wrong), NEW (not in the golden
+  file) or FAIL (couldn't be opened), along with the time it took.
+
+  Usage: stella-regress [-frames N] [-threads N] [-golden FILE]
+                        [-update 1] [-<setting> <value> ...] rom|dir ...
+
+  Any other '-<setting> <value>' pair is passed through to the Settings
+  object of every ROM, so for example running once with '-cpu low' and
+  once with '-cpu high' against the same golden file checks that both
+  6502 cores produce the same results, and compares their speed.
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <vector>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "bspf.hxx"
+#include "Array.hxx"
+#include "Console.hxx"
+#include "Control.hxx"
+#include "Event.hxx"
+#include "EventHandler.hxx"
+#include "FSNode.hxx"
+#include "OSystemHeadless.hxx"
+#include "Props.hxx"
+#include "Settings.hxx"
+#include "SettingsUNIX.hxx"
+#include "SoundNull.hxx"
+#include "Switches.hxx"
+#include "System.hxx"
+#include "TIA.hxx"
+#include "TIASnd.hxx"
+#include "ThreadPool.hxx"
+
+// Frames between the checkpoint hashes used to locate a difference
+static const uInt32 kCheckpointInterval = 60;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static uInt64 getTimeInMicros()
+{
+  timeval now;
+  gettimeofday(&now, 0);
+
+  return (uInt64)now.tv_sec * 1000000 + (uInt64)now.tv_usec;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static uInt64 combine(uInt64 hash, uInt64 value)
+{
+  return (hash ^ value) * 0x9e3779b97f4a7c15ULL + (hash >> 31);
+}
+
+/**
+  A silent sound device which runs every register write through a
+  TIASound, the same as a real one would, and hashes the samples produced.
+  The TIA clocks its audio twice per scanline, so one sample is made for
+  every 38 CPU cycles.
+*/
+class SoundHash : public SoundNull
+{
+  public:
+    SoundHash(OSystem* osystem)
+      : SoundNull(osystem), myTIASound(31400, 31400, 1) { reset(); }
+
+    void reset()
+    {
+      myTIASound.reset();
+      myLastCycle = 0;
+      myHash = 0;
+    }
+
+    void adjustCycleCounter(Int32 amount) { myLastCycle += amount; }
+
+    void set(uInt16 addr, uInt8 value, Int32 cycle)
+    {
+      update(cycle);
+      myTIASound.set(addr, value);
+    }
+
+    /**
+      Produce the samples up to the given cycle, and answer the hash of
+      all samples produced so far.
+    */
+    uInt64 update(Int32 cycle)
+    {
+      uInt8 samples[1024];
+      while(cycle - myLastCycle >= 38)
+      {
+        uInt32 count = BSPF_min((uInt32)(cycle - myLastCycle) / 38, 1024u);
+        myTIASound.process(samples, count);
+        myLastCycle += count * 38;
+        myHash = combine(myHash, Console::stateHash(samples, count));
+      }
+      return myHash;
+    }
+
+  private:
+    TIASound myTIASound;
+    Int32 myLastCycle;
+    uInt64 myHash;
+};
+
+/**
+  A headless OSystem using the hashing sound device.
+*/
+class OSystemRegress : public OSystemHeadless
+{
+  public:
+    bool create()
+    {
+      if(!OSystemHeadless::create())
+        return false;
+
+      delete mySound;
+      mySound = mySoundHash = new SoundHash(this);
+      return true;
+    }
+
+    SoundHash& soundHash() { return *mySoundHash; }
+
+  private:
+    SoundHash* mySoundHash;
+};
+
+// The outcome of running one ROM
+struct RomResult
+{
+  string file, md5, name;
+  bool opened;
+  uInt64 video, audio;
+  Common::Array<uInt64> checkpoints;
+  uInt64 micros;
+};
+
+// A ROM's entry in the golden file
+struct GoldenEntry
+{
+  string name;
+  uInt32 frames;
+  uInt64 video, audio;
+  Common::Array<uInt64> checkpoints;
+};
+typedef map<string, GoldenEntry> GoldenMap;
+
+/**
+  Runs one ROM of the list per item.
+*/
+class RegressJob : public ThreadPool::Job
+{
+  public:
+    RegressJob(Common::Array<RomResult>& results, const StringList& settings,
+               uInt32 frames)
+      : myResults(results), mySettings(settings), myFrames(frames) { }
+
+    void run(uInt32 item)
+    {
+      RomResult& result = myResults[item];
+      result.opened = false;
+
+      OSystemRegress* osystem = new OSystemRegress();
+      SettingsUNIX* settings = new SettingsUNIX(osystem);
+      Console* console = NULL;
+
+      // Only the settings given on the commandline are used, and RAM
+      // always starts the same way
+      settings->setInt("randseed", 1);
+      for(uInt32 i = 0; i + 1 < mySettings.size(); i += 2)
+        settings->setString(mySettings[i], mySettings[i+1]);
+      settings->setBool("sound", false);
+      settings->setBool("showinfo", false);
+      settings->validate();
+
+      if(osystem->create())
+        console = osystem->openConsole(result.file, result.md5);
+
+      if(console)
+      {
+        result.opened = true;
+        result.name = console->properties().get(Cartridge_Name);
+        runConsole(*console, *osystem, result);
+      }
+
+      delete console;
+      delete osystem;
+      delete settings;
+    }
+
+  private:
+    void runConsole(Console& console, OSystemRegress& osystem,
+                    RomResult& result)
+    {
+      Event& event = *osystem.eventHandler().event();
+      TIA& tia = console.tia();
+      System& system = console.system();
+      SoundHash& sound = osystem.soundHash();
+
+      uInt64 video = 0, audio = 0;
+      uInt64 startTime = getTimeInMicros();
+      for(uInt32 frame = 0; frame < myFrames; ++frame)
+      {
+        setInputs(event, frame);
+        console.controller(Controller::Left).update();
+        console.controller(Controller::Right).update();
+        console.switches().update();
+        tia.update();
+
+        video = combine(video, Console::stateHash(tia.currentFrameBuffer(),
+                                                  tia.width() * tia.height()));
+        audio = sound.update(system.cycles());
+
+        if((frame + 1) % kCheckpointInterval == 0)
+          result.checkpoints.push_back(combine(video, audio));
+      }
+      result.micros = getTimeInMicros() - startTime;
+      result.video = video;
+      result.audio = audio;
+    }
+
+    /**
+      The scripted inputs: the reset switch is pressed for a few frames
+      every ten seconds (to start the game), and in between both joysticks
+      and the first paddle of each pair wander about, changing every eight
+      frames in a fixed pseudo-random pattern.
+    */
+    void setInputs(Event& event, uInt32 frame)
+    {
+      event.set(Event::ConsoleReset, frame % 600 >= 30 && frame % 600 < 36);
+
+      uInt32 r = (frame / 8) * 1103515245 + 12345;
+      r ^= r >> 16;
+      event.set(Event::JoystickZeroUp,    (r & 0x03) == 1);
+      event.set(Event::JoystickZeroDown,  (r & 0x03) == 2);
+      event.set(Event::JoystickZeroLeft,  (r & 0x0c) == 4);
+      event.set(Event::JoystickZeroRight, (r & 0x0c) == 8);
+      event.set(Event::JoystickZeroFire1, (r & 0x10) != 0);
+      event.set(Event::JoystickOneUp,     (r & 0x60) == 0x20);
+      event.set(Event::JoystickOneDown,   (r & 0x60) == 0x40);
+      event.set(Event::JoystickOneLeft,   (r & 0x180) == 0x80);
+      event.set(Event::JoystickOneRight,  (r & 0x180) == 0x100);
+      event.set(Event::JoystickOneFire1,  (r & 0x200) != 0);
+      event.set(Event::PaddleZeroDecrease, (r & 0xc00) == 0x400);
+      event.set(Event::PaddleZeroIncrease, (r & 0xc00) == 0x800);
+      event.set(Event::PaddleZeroFire,     (r & 0x1000) != 0);
+      event.set(Event::PaddleTwoDecrease,  (r & 0x6000) == 0x2000);
+      event.set(Event::PaddleTwoIncrease,  (r & 0x6000) == 0x4000);
+      event.set(Event::PaddleTwoFire,      (r & 0x8000) != 0);
+    }
+
+  private:
+    Common::Array<RomResult>& myResults;
+    const StringList& mySettings;
+    uInt32 myFrames;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static bool isRomFile(const string& name)
+{
+  string::size_type dot = name.rfind('.');
+  if(dot == string::npos)
+    return false;
+
+  string ext = name.substr(dot + 1);
+  for(uInt32 i = 0; i < ext.length(); ++i)
+    ext[i] = tolower(ext[i]);
+
+  return ext == "a26" || ext == "bin" || ext == "rom" ||
+         ext == "zip" || ext == "gz";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void findRoms(const FilesystemNode& node, vector<string>& roms)
+{
+  FSList children;
+  if(!node.getChildren(children, FilesystemNode::kListAll))
+    return;
+
+  for(uInt32 i = 0; i < children.size(); ++i)
+  {
+    if(children[i].isDirectory())
+      findRoms(children[i], roms);
+    else if(isRomFile(children[i].getName()))
+      roms.push_back(children[i].getPath());
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static string toHex(uInt64 value)
+{
+  ostringstream buf;
+  buf << hex << setfill('0') << setw(16) << value;
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static bool loadGolden(const string& filename, GoldenMap& golden)
+{
+  ifstream in(filename.c_str());
+  if(!in)
+    return false;
+
+  // Each line is: md5 frames video audio checkpoint,... name
+  string line;
+  while(getline(in, line))
+  {
+    if(line.empty() || line[0] == '#')
+      continue;
+
+    istringstream buf(line);
+    string md5, video, audio, checkpoints;
+    GoldenEntry entry;
+    buf >> md5 >> entry.frames >> video >> audio >> checkpoints;
+    if(!buf)
+    {
+      cerr << "WARNING: Ignoring bad line in " << filename << ": "
+           << line << endl;
+      continue;
+    }
+    getline(buf >> ws, entry.name);
+
+    entry.video = strtoull(video.c_str(), NULL, 16);
+    entry.audio = strtoull(audio.c_str(), NULL, 16);
+    if(checkpoints != "-")
+    {
+      istringstream list(checkpoints);
+      string value;
+      while(getline(list, value, ','))
+        entry.checkpoints.push_back(strtoull(value.c_str(), NULL, 16));
+    }
+    golden[md5] = entry;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static bool saveGolden(const string& filename, const GoldenMap& golden)
+{
+  ofstream out(filename.c_str());
+  if(!out)
+    return false;
+
+  out << "# stella-regress golden file" << endl
+      << "# md5 frames video audio checkpoints name" << endl;
+  for(GoldenMap::const_iterator i = golden.begin(); i != golden.end(); ++i)
+  {
+    const GoldenEntry& entry = i->second;
+    out << i->first << " " << entry.frames << " " << toHex(entry.video)
+        << " " << toHex(entry.audio) << " ";
+    for(uInt32 j = 0; j < entry.checkpoints.size(); ++j)
+      out << (j > 0 ? "," : "") << toHex(entry.checkpoints[j]);
+    if(entry.checkpoints.size() == 0)
+      out << "-";
+    out << " " << entry.name << endl;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static string compare(const RomResult& result, const GoldenEntry& golden,
+                      uInt32 frames, bool& same)
+{
+  same = false;
+  if(golden.frames != frames)
+  {
+    ostringstream buf;
+    buf << "golden file has " << golden.frames << " frames";
+    return buf.str();
+  }
+
+  same = result.video == golden.video && result.audio == golden.audio;
+  if(same)
+    return "";
+
+  // Find the first checkpoint which differs
+  string what = result.video != golden.video ?
+    (result.audio != golden.audio ? "video and audio" : "video") : "audio";
+  uInt32 first = 0;
+  while(first < result.checkpoints.size() &&
+        first < golden.checkpoints.size() &&
+        result.checkpoints[first] == golden.checkpoints[first])
+    ++first;
+
+  ostringstream buf;
+  buf << what << " differ from frame " << first * kCheckpointInterval;
+  if(first < result.checkpoints.size())
+    buf << "-" << (first + 1) * kCheckpointInterval - 1;
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int argc, char* argv[])
+{
+  uInt32 frames = 600, threads = 0;
+  string goldenfile = "regress.golden";
+  bool update = false;
+  StringList settings, args;
+  for(int i = 1; i < argc; ++i)
+  {
+    string key = argv[i];
+    if(key[0] == '-' && i + 1 < argc)
+    {
+      key = key.substr(1, key.length());
+      string value = argv[++i];
+      if(key == "frames")
+        frames = atoi(value.c_str());
+      else if(key == "threads")
+        threads = atoi(value.c_str());
+      else if(key == "golden")
+        goldenfile = value;
+      else if(key == "update")
+        update = value == "1" || value == "true";
+      else
+      {
+        settings.push_back(key);
+        settings.push_back(value);
+      }
+    }
+    else
+      args.push_back(key);
+  }
+
+  if(args.isEmpty() || frames == 0)
+  {
+    cerr << "Usage: stella-regress [-frames N] [-threads N] [-golden FILE] "
+         << "[-update 1] [-<setting> <value> ...] rom|dir ..." << endl;
+    return 1;
+  }
+
+  // Directories are listed in sorted order, so that the report (and which
+  // of several copies of a ROM is used) doesn't depend on the filesystem
+  StringList roms;
+  for(uInt32 i = 0; i < args.size(); ++i)
+  {
+    FilesystemNode node(args[i]);
+    if(node.isDirectory())
+    {
+      vector<string> found;
+      findRoms(node, found);
+      sort(found.begin(), found.end());
+      for(uInt32 j = 0; j < found.size(); ++j)
+        roms.push_back(found[j]);
+    }
+    else
+      roms.push_back(args[i]);
+  }
+
+  GoldenMap golden;
+  if(!loadGolden(goldenfile, golden) && !update)
+    cerr << "WARNING: Couldn't read golden file " << goldenfile
+         << "; every ROM will be NEW" << endl;
+
+  if(threads == 0)
+  {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    threads = online > 0 ? (uInt32)online : 1;
+  }
+
+  Common::Array<RomResult> results;
+  for(uInt32 i = 0; i < roms.size(); ++i)
+  {
+    RomResult result;
+    result.file = roms[i];
+    result.opened = false;
+    result.video = result.audio = result.micros = 0;
+    results.push_back(result);
+  }
+
+  uInt64 startTime = getTimeInMicros();
+  {
+    ThreadPool pool(BSPF_min(threads, BSPF_max(roms.size(), 1u)));
+    RegressJob job(results, settings, frames);
+    pool.run(job, results.size());
+  }
+  uInt64 elapsed = getTimeInMicros() - startTime;
+
+  // Report on each ROM, in the order they were given
+  uInt32 same = 0, differ = 0, added = 0, failed = 0;
+  uInt64 emulated = 0;
+  map<string, bool> seen;
+  for(uInt32 i = 0; i < results.size(); ++i)
+  {
+    const RomResult& result = results[i];
+    if(!result.opened)
+    {
+      cout << "FAIL  " << result.file << endl;
+      ++failed;
+      continue;
+    }
+    if(seen[result.md5])   // Same ROM under another filename
+      continue;
+    seen[result.md5] = true;
+
+    string status, detail;
+    GoldenMap::iterator entry = golden.find(result.md5);
+    if(entry == golden.end())
+    {
+      status = "NEW ";
+      ++added;
+    }
+    else
+    {
+      bool ok;
+      detail = compare(result, entry->second, frames, ok);
+      status = ok ? "OK  " : "DIFF";
+      ++(ok ? same : differ);
+    }
+
+    double seconds = result.micros > 0 ? result.micros / 1000000.0 : 1e-6;
+    emulated += result.micros;
+    cout << status << "  " << fixed << setprecision(1)
+         << setw(9) << (result.micros / 1000.0) << " ms  "
+         << setw(9) << (frames / seconds) << " fps  "
+         << result.name
+         << (detail != "" ? "  (" + detail + ")" : "") << endl;
+
+    if(update)
+    {
+      GoldenEntry& g = golden[result.md5];
+      g.name = result.name;
+      g.frames = frames;
+      g.video = result.video;
+      g.audio = result.audio;
+      g.checkpoints = result.checkpoints;
+    }
+  }
+
+  cout << endl << seen.size() << " ROMs, " << same << " OK, " << differ
+       << " DIFF, " << added << " NEW, " << failed << " FAIL" << endl
+       << fixed << setprecision(2)
+       << "Emulation " << (emulated / 1000000.0) << " s on " << threads
+       << " threads, wall clock " << (elapsed / 1000000.0) << " s" << endl;
+
+  if(update)
+  {
+    if(saveGolden(goldenfile, golden))
+      cout << "Golden file " << goldenfile << " updated" << endl;
+    else
+    {
+      cerr << "ERROR: Couldn't write golden file " << goldenfile << endl;
+      return 1;
+    }
+  }
+
+  return (differ > 0 || failed > 0) ? 1 : 0;
+}
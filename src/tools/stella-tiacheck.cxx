@@ -0,0 +1,287 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+/**
+  Differential test of the TIA renderers.  For each seed, a ROM full of
+  random TIA register writes is made up, and run on two libstella
+  instances, one with '-tiarender standard' and one with '-tiarender
+  bitplane'.  Every frame of the two must be the same, and so must their
+  RAM, where the ROM keeps what it reads from the collision registers.
+
+  The ROM is a 512K Tigervision (3F) cartridge of straight-line code, so
+  that no loops are needed: each 2K bank is a random sequence of register
+  writes, collision reads, WSYNCs and delays, which jumps through the
+  fixed bank to the next one.  The values written favour zero, so that
+  every combination of objects being on and off (and so every special
+  case of the standard renderer) comes up often.  The generator counts
+  cycles to put a VSYNC and VBLANK in about every 262 scanlines.
+
+  Usage: stella-tiacheck [frames] [first seed] [seeds]
+*/
+
+#include <cstdlib>
+#include <cstring>
+
+#include "bspf.hxx"
+#include "../libstella/libstella.h"
+
+// The cartridge is made of 2K banks, the last of which is always at $F800
+static const uInt32 kBankSize = 2048;
+static const uInt32 kNumBanks = 256;
+
+// The code in the fixed bank: start up, then switch to the bank in X and
+// jump to its start
+static const uInt16 kStart = 0xf800;
+static const uInt16 kNextBank = 0xf805;
+static const uInt8 ourFixedBank[] = {
+  0x78, 0xd8, 0xa2, 0x00,        // F800  SEI / CLD / LDX #0
+  0x9a,                          //       TXS
+  0x86, 0x3f,                    // F805  STX $3F
+  0x4c, 0x00, 0xf0               //       JMP $F000
+};
+
+// TIA registers, as written through the mirror at $40, since any write
+// below $40 also switches banks
+enum {
+  VSYNC = 0x40, VBLANK, WSYNC, RSYNC, NUSIZ0, NUSIZ1, COLUP0, COLUP1,
+  COLUPF, COLUBK, CTRLPF, REFP0, REFP1, PF0, PF1, PF2, RESP0, RESP1,
+  RESM0, RESM1, RESBL, AUDC0, AUDC1, AUDF0, AUDF1, AUDV0, AUDV1,
+  GRP0, GRP1, ENAM0, ENAM1, ENABL, HMP0, HMP1, HMM0, HMM1, HMBL,
+  VDELP0, VDELP1, VDELBL, RESMP0, RESMP1, HMOVE, HMCLR, CXCLR
+};
+
+// The registers given random values, with the ones that decide which
+// objects are on (and so which case of the renderer is used) more often
+static const uInt8 ourRegisters[] = {
+  NUSIZ0, NUSIZ1, COLUP0, COLUP1, COLUPF, COLUBK, CTRLPF, CTRLPF,
+  REFP0, REFP1, PF0, PF1, PF2, PF0, PF1, PF2, GRP0, GRP1, GRP0, GRP1,
+  ENAM0, ENAM1, ENABL, ENAM0, ENAM1, ENABL, HMP0, HMP1, HMM0, HMM1, HMBL,
+  VDELP0, VDELP1, VDELBL, RESMP0, RESMP1
+};
+
+// The registers which are strobed
+static const uInt8 ourStrobes[] = {
+  RESP0, RESP1, RESM0, RESM1, RESBL, HMOVE, HMCLR, CXCLR
+};
+
+/**
+  Writes the random code into the banks, keeping track of the scanline
+  and cycle each instruction runs at.
+*/
+class RomMaker
+{
+  public:
+    RomMaker(uInt8* image, uInt32 seed)
+      : myImage(image), myRandom(seed), myLine(0), myCycle(0),
+        myVisible(false) { }
+
+    void make()
+    {
+      for(uInt32 bank = 0; bank < kNumBanks - 1; ++bank)
+      {
+        myPC = bank * kBankSize;
+
+        // Leave room for the longest instruction sequence, and the jump
+        // to the next bank
+        while(myPC < (bank + 1) * kBankSize - 32)
+          instruction();
+
+        op2(0xa2, (bank + 1) % (kNumBanks - 1), 2);   // LDX #next
+        op3(0x4c, kNextBank, 3 + 3 + 3);             // JMP, STX, JMP
+      }
+
+      uInt8* fixed = myImage + (kNumBanks - 1) * kBankSize;
+      memcpy(fixed, ourFixedBank, sizeof(ourFixedBank));
+      fixed[0x7fc] = kStart & 0xff;
+      fixed[0x7fd] = kStart >> 8;
+    }
+
+  private:
+    void instruction()
+    {
+      // A new frame every 262 lines, with VBLANK for the first 20 and the
+      // last 12; anything else in between
+      if(myLine >= 262)
+      {
+        op2(0xa9, 0x02, 2);                  // LDA #2
+        op2(0x85, VBLANK, 3);
+        op2(0x85, VSYNC, 3);
+        wsync(); wsync(); wsync();
+        op2(0xa9, 0x00, 2);                  // LDA #0
+        op2(0x85, VSYNC, 3);
+        myLine = 3;
+        myVisible = false;
+      }
+      else if(myLine >= 20 && myLine < 250 && !myVisible)
+      {
+        op2(0xa9, 0x00, 2);
+        op2(0x85, VBLANK, 3);
+        myVisible = true;
+      }
+      else if(myLine >= 250 && myVisible)
+      {
+        op2(0xa9, 0x02, 2);
+        op2(0x85, VBLANK, 3);
+        myVisible = false;
+      }
+
+      uInt32 r = random() % 100;
+      if(r < 50)
+      {
+        // A register gets a random value, or zero
+        uInt8 reg = ourRegisters[random() % sizeof(ourRegisters)];
+        op2(0xa9, random() % 3 == 0 ? 0 : random() & 0xff, 2);   // LDA #
+        op2(0x85, reg, 3);                                       // STA
+      }
+      else if(r < 60)
+        op2(0x85, ourStrobes[random() % sizeof(ourStrobes)], 3);  // STA
+      else if(r < 70)
+      {
+        op2(0xa5, 0x40 + random() % 8, 3);         // LDA CXxxxx
+        op2(0x85, 0x80 + random() % 0x80, 3);      // STA RAM
+      }
+      else if(r < 75)
+        wsync();
+      else if(r < 90)
+        op1(0xea, 2);                              // NOP
+      else
+        op2(0x24, 0x80, 3);                        // BIT $80
+    }
+
+    void wsync()
+    {
+      op2(0x85, WSYNC, 3);
+      ++myLine;
+      myCycle = 0;
+    }
+
+    void op1(uInt8 opcode, uInt32 cycles)
+    {
+      myImage[myPC++] = opcode;
+      count(cycles);
+    }
+
+    void op2(uInt8 opcode, uInt8 operand, uInt32 cycles)
+    {
+      myImage[myPC++] = opcode;
+      myImage[myPC++] = operand;
+      count(cycles);
+    }
+
+    void op3(uInt8 opcode, uInt16 address, uInt32 cycles)
+    {
+      myImage[myPC++] = opcode;
+      myImage[myPC++] = address & 0xff;
+      myImage[myPC++] = address >> 8;
+      count(cycles);
+    }
+
+    void count(uInt32 cycles)
+    {
+      myCycle += cycles;
+      myLine += myCycle / 76;
+      myCycle %= 76;
+    }
+
+    uInt32 random()
+    {
+      myRandom = myRandom * 1103515245 + 12345;
+      return (myRandom >> 16) & 0x7fff;
+    }
+
+  private:
+    uInt8* myImage;
+    uInt32 myRandom;
+    uInt32 myPC;
+    uInt32 myLine, myCycle;
+    bool myVisible;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static bool checkSeed(uInt32 seed, uInt32 frames)
+{
+  uInt32 size = kNumBanks * kBankSize;
+  uInt8* image = new uInt8[size];
+  memset(image, 0xea, size);   // NOP
+  RomMaker(image, seed).make();
+
+  const char* standard[] = { "type", "3F", "tiarender", "standard", NULL };
+  const char* bitplane[] = { "type", "3F", "tiarender", "bitplane", NULL };
+  stella_t* s = stella_create(image, size, standard);
+  stella_t* b = stella_create(image, size, bitplane);
+  delete[] image;
+  if(!s || !b)
+  {
+    cout << "Seed " << seed << ": FAIL (couldn't create instance)" << endl;
+    if(s) stella_destroy(s);
+    if(b) stella_destroy(b);
+    return false;
+  }
+
+  bool same = true;
+  for(uInt32 frame = 0; frame < frames && same; ++frame)
+  {
+    stella_step(s);
+    stella_step(b);
+
+    unsigned int width, height;
+    const unsigned char* sp = stella_framebuffer(s, &width, &height);
+    const unsigned char* bp = stella_framebuffer(b, NULL, NULL);
+    for(uInt32 i = 0; i < width * height; ++i)
+    {
+      if(sp[i] != bp[i])
+      {
+        cout << "Seed " << seed << ": FAIL (frame " << frame << ", line "
+             << i / width << ", pixel " << i % width << ": standard "
+             << (int)sp[i] << ", bitplane " << (int)bp[i] << ")" << endl;
+        same = false;
+        break;
+      }
+    }
+
+    if(same && memcmp(stella_ram(s), stella_ram(b), 128) != 0)
+    {
+      cout << "Seed " << seed << ": FAIL (frame " << frame
+           << ", collisions differ)" << endl;
+      same = false;
+    }
+  }
+
+  stella_destroy(s);
+  stella_destroy(b);
+
+  return same;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int argc, char* argv[])
+{
+  uInt32 frames = argc > 1 ? atoi(argv[1]) : 120;
+  uInt32 first = argc > 2 ? atoi(argv[2]) : 1;
+  uInt32 seeds = argc > 3 ? atoi(argv[3]) : 20;
+
+  uInt32 failures = 0;
+  for(uInt32 seed = first; seed < first + seeds; ++seed)
+    if(!checkSeed(seed, frames))
+      ++failures;
+
+  cout << seeds << " seeds, " << frames << " frames: "
+       << (failures == 0 ? "OK" : "FAILED") << endl;
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,62 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef OSYSTEM_HEADLESS_HXX
+#define OSYSTEM_HEADLESS_HXX
+
+#include "bspf.hxx"
+#include "OSystem.hxx"
+#include "OSystemUNIX.hxx"
+#include "SoundNull.hxx"
+
+/**
+  An OSystem which never touches the video hardware and always uses
+  the null sound device.  It's used by the tools which run the emulation
+  core without any window or event loop (stella-bench, stella-regress,
+  libstella).
+
+  Consoles are created with openConsole(), and are never attached to
+  the OSystem itself.
+*/
+class OSystemHeadless : public OSystemUNIX
+{
+  public:
+    OSystemHeadless() : OSystemUNIX() { }
+    virtual ~OSystemHeadless() { }
+
+    bool create()
+    {
+      if(!OSystem::create())
+        return false;
+
+      // Replace whatever sound device was created with a silent one
+      delete mySound;
+      mySound = new SoundNull(this);
+      return true;
+    }
+
+  protected:
+    bool queryVideoHardware()
+    {
+      myDesktopWidth  = 640;
+      myDesktopHeight = 480;
+      return true;
+    }
+};
+
+#endif
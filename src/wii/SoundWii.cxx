@@ -51,6 +51,7 @@ myIsEnabled(osystem->settings().getBool("sound")),
 myIsInitializedFlag(false),
 myLastRegisterSetCycle(0),
 myDisplayFrameRate(60.0),
+mySpeed(1),
 myNumChannels(1),
 myFragmentSizeLogBase2(0),
 myIsMuted(true),
@@ -87,6 +88,7 @@ void SoundWii::open()
     // Make sure the sound queue is clear
     myRegWriteQueue.clear();
     myTIASound.reset();
+    myStats.reset();
 
     SDL_BuildAudioCVT(
         &audio_convert,
@@ -154,6 +156,7 @@ void SoundWii::mute(bool state)
 
         ResetAudio();    
         myRegWriteQueue.clear();
+        myStats.restart();
     }
 }
 
@@ -167,6 +170,7 @@ void SoundWii::reset()
         myLastRegisterSetCycle = 0;
         myTIASound.reset();
         myRegWriteQueue.clear();
+        myStats.restart();
         ResetAudio();
     }
 }
@@ -231,14 +235,29 @@ void SoundWii::setFrameRate(float framerate)
     myDisplayFrameRate = framerate;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWii::setSpeed(uInt32 speed)
+{
+    mySpeed = speed;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundWii::set(uInt16 addr, uInt8 value, Int32 cycle)
 {
 
+    // When running as fast as possible there's no way to keep up with the
+    // writes, so the sound just follows the registers
+    if(mySpeed == 0)
+    {
+        myTIASound.set(addr, value);
+        myLastRegisterSetCycle = cycle;
+        return;
+    }
+
     // First, calulate how many seconds would have past since the last
-    // register write on a real 2600
+    // register write on a real 2600 (compressed when running faster)
     double delta = (((double)(cycle - myLastRegisterSetCycle)) / 
-        (1193191.66666667));
+        (1193191.66666667 * mySpeed));
 
     // Now, adjust the time based on the frame rate the user has selected. For
     // the sound to "scale" correctly, we have to know the games real frame 
@@ -274,19 +293,28 @@ void SoundWii::processFragment(uInt8* stream, Int32 length)
     uInt32 channels = 1 /*myHardwareSpec.channels*/;
     length = length / channels;
 
+    // A write at the end of the queue is heard after the sound queued
+    // ahead of it, and the fragment being played while this one is made
+    double queued = myRegWriteQueue.duration();
+    double period = (double)length / SAMPLERATE;
+    myStats.fragment(myOSystem->getTicks(), (uInt32)(period * 1000000.0),
+        (uInt32)(queued * 1000000.0), (uInt32)((queued + period) * 1000000.0));
+
     // If there are excessive items on the queue then we'll remove some
-    if(myRegWriteQueue.duration() > 
-        (myFragmentSizeLogBase2 / myDisplayFrameRate))
+    if(queued > (myFragmentSizeLogBase2 / myDisplayFrameRate))
     {
         double removed = 0.0;
-        while(removed < ((myFragmentSizeLogBase2 - 1) / myDisplayFrameRate))
+        uInt32 writes = 0;
+        while(removed < ((myFragmentSizeLogBase2 - 1) / myDisplayFrameRate) &&
+              myRegWriteQueue.size() > 0)
         {
             RegWrite& info = myRegWriteQueue.front();
             removed += info.delta;
             myTIASound.set(info.addr, info.value);
             myRegWriteQueue.dequeue();
+            ++writes;
         }
-        //    cout << "Removed Items from RegWriteQueue!" << endl;
+        myStats.skipped(writes);
     }
 
     double position = 0.0;
@@ -301,6 +329,7 @@ void SoundWii::processFragment(uInt8* stream, Int32 length)
             //    myTIASound.process(stream + (uInt32)position, length - (uInt32)position);
             myTIASound.process(stream + ((uInt32)position * channels),
                 length - (uInt32)position);
+            myStats.underrun();
 
             // Since we had to fill the fragment we'll reset the cycle counter
             // to zero.  NOTE: This isn't 100% correct, however, it'll do for
@@ -356,6 +385,12 @@ void SoundWii::processFragment(uInt8* stream, Int32 length)
     }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const SoundStats* SoundWii::stats() const
+{
+    return &myStats;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool SoundWii::load(Deserializer& in)
 {
@@ -405,6 +440,35 @@ bool SoundWii::load(Deserializer& in)
     return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundWii::skip(Deserializer& in)
+{
+    string device = "TIASound";
+
+    try
+    {
+        if(in.getString() != device)
+            return false;
+
+        // The six sound registers, and myLastRegisterSetCycle
+        for(uInt32 i = 0; i < 6; ++i)
+            in.getByte();
+        in.getInt();
+    }
+    catch(char *msg)
+    {
+        cerr << msg << endl;
+        return false;
+    }
+    catch(...)
+    {
+        cerr << "Unknown error in skip state for " << device << endl;
+        return false;
+    }
+
+    return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool SoundWii::save(Serializer& out)
 {
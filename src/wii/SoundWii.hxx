@@ -27,6 +27,7 @@ class OSystem;
 #include "bspf.hxx"
 #include "TIASnd.hxx"
 #include "Sound.hxx"
+#include "SoundStats.hxx"
 
 /**
   This class implements the sound API for WII.
@@ -79,6 +80,17 @@ class SoundWii : public Sound
     */
     void setFrameRate(float framerate);
 
+    /**
+      Sets how many times faster than real time the emulation is running
+      (1 being real time), so that queued sound doesn't fall behind.  The
+      time between register writes is compressed by that factor, and with
+      a speed of 0 (as fast as possible) writes take effect immediately
+      without any sound being queued for them.
+
+      @param speed The speed multiplier
+    */
+    void setSpeed(uInt32 speed);
+
     /**
       Initializes the sound device.  This must be called before any
       calls are made to derived methods.
@@ -136,6 +148,12 @@ class SoundWii : public Sound
     */
     void adjustVolume(Int8 direction);
 
+    /**
+      Answers statistics about how well the sound is keeping up (underruns,
+      dropped writes, jitter, queue depth and latency).
+    */
+    const SoundStats* stats() const;
+
   public:
     /**
       Loads the current state of this device from the given Deserializer.
@@ -145,6 +163,15 @@ class SoundWii : public Sound
     */
     bool load(Deserializer& in);
 
+    /**
+      Reads past the state of this device in the given Deserializer,
+      without changing the device.
+
+      @param in The deserializer device to read from.
+      @return The result of the skip.  True on success, false on failure.
+    */
+    bool skip(Deserializer& in);
+
     /**
       Saves the current state of this device to the given Serializer.
 
@@ -253,6 +280,9 @@ class SoundWii : public Sound
     // Indicates the base framerate depending on if the ROM is NTSC or PAL
     float myDisplayFrameRate;
 
+    // How many times faster than real time the emulation is running
+    uInt32 mySpeed;
+
     // Indicates the number of channels (mono or stereo)
     uInt32 myNumChannels;
 
@@ -270,6 +300,9 @@ class SoundWii : public Sound
 
     // Queue of TIA register writes
     RegWriteQueue myRegWriteQueue;
+
+    // Statistics about the sound, recorded as it plays
+    SoundStats myStats;
 };
 
 #endif  // SOUND_SUPPORT
@@ -323,6 +323,12 @@ bool SoundWinCE::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundWinCE::skip(Deserializer& in)
+{
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool SoundWinCE::save(Serializer& out)
 {
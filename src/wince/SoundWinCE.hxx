@@ -54,6 +54,7 @@ class SoundWinCE : public Sound
     void setVolume(Int32 percent);
     void adjustVolume(Int8 direction);
     bool load(Deserializer& in);
+    bool skip(Deserializer& in);
     bool save(Serializer& out);
 	void update(void);
 